@@ -0,0 +1,751 @@
+/*
+ * Copyright © 2018 Benjamin Otte
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtkbtreeprivate.h"
+
+#include <string.h>
+
+/* Leaves store their elements in an array. Inner nodes store arrays
+ * of their children, the number of elements in each child and the
+ * augment of each child, so a lookup only touches a few cache lines
+ * per level.
+ *
+ * Like in GtkRbTree, augments are updated lazily: modifications mark
+ * the nodes on the path from the root dirty, and dirty nodes get
+ * their augment computed again the next time it is needed.
+ */
+
+/* maximum number of children of inner nodes */
+#define BRANCH 16
+/* leaves are sized to hold about this many bytes of elements */
+#define LEAF_BYTES 512
+#define MIN_LEAF_CAPACITY 4
+
+#define ALIGN(size) (((size) + 7) & ~(gsize) 7)
+
+typedef struct _GtkBTreeNode GtkBTreeNode;
+
+struct _GtkBTreeNode
+{
+  guint n_children; /* number of elements for leaves */
+  guint leaf :1;
+  guint dirty :1;
+};
+
+#define HEADER_SIZE ALIGN (sizeof (GtkBTreeNode))
+
+struct _GtkBTree
+{
+  guint ref_count;
+
+  gsize element_size;
+  gsize augment_size;
+  GtkBTreeAugmentFunc augment_func;
+  GtkBTreeCombineFunc combine_func;
+  GDestroyNotify clear_func;
+
+  guint leaf_capacity;
+  gsize leaf_size;
+  gsize inner_size;
+  gsize sizes_offset;
+  gsize augments_offset;
+
+  GtkBTreeNode *root; /* NULL if empty */
+  guint size;
+  gpointer root_augment;
+};
+
+/* Inner nodes have room for one more child than allowed, so they
+ * can be split after inserting. */
+static inline GtkBTreeNode **
+node_children (GtkBTreeNode *node)
+{
+  return (GtkBTreeNode **) ((guchar *) node + HEADER_SIZE);
+}
+
+static inline guint *
+node_sizes (GtkBTree     *tree,
+            GtkBTreeNode *node)
+{
+  return (guint *) ((guchar *) node + tree->sizes_offset);
+}
+
+static inline gpointer
+node_augment (GtkBTree     *tree,
+              GtkBTreeNode *node,
+              guint         i)
+{
+  return (guchar *) node + tree->augments_offset + i * tree->augment_size;
+}
+
+static inline gpointer
+node_element (GtkBTree     *tree,
+              GtkBTreeNode *node,
+              guint         i)
+{
+  return (guchar *) node + HEADER_SIZE + i * tree->element_size;
+}
+
+static inline guint
+node_capacity (GtkBTree     *tree,
+               GtkBTreeNode *node)
+{
+  return node->leaf ? tree->leaf_capacity : BRANCH;
+}
+
+static GtkBTreeNode *
+gtk_btree_node_new (GtkBTree *tree,
+                    gboolean  leaf)
+{
+  GtkBTreeNode *node;
+
+  node = g_slice_alloc0 (leaf ? tree->leaf_size : tree->inner_size);
+  node->leaf = leaf;
+  node->dirty = TRUE;
+
+  return node;
+}
+
+static void
+gtk_btree_node_free (GtkBTree     *tree,
+                     GtkBTreeNode *node)
+{
+  g_slice_free1 (node->leaf ? tree->leaf_size : tree->inner_size, node);
+}
+
+static void
+gtk_btree_node_free_deep (GtkBTree     *tree,
+                          GtkBTreeNode *node)
+{
+  guint i;
+
+  if (node->leaf)
+    {
+      if (tree->clear_func)
+        {
+          for (i = 0; i < node->n_children; i++)
+            tree->clear_func (node_element (tree, node, i));
+        }
+    }
+  else
+    {
+      for (i = 0; i < node->n_children; i++)
+        gtk_btree_node_free_deep (tree, node_children (node)[i]);
+    }
+
+  gtk_btree_node_free (tree, node);
+}
+
+static guint
+gtk_btree_node_get_size (GtkBTree     *tree,
+                         GtkBTreeNode *node)
+{
+  guint *sizes;
+  guint i, size;
+
+  if (node->leaf)
+    return node->n_children;
+
+  sizes = node_sizes (tree, node);
+  size = 0;
+  for (i = 0; i < node->n_children; i++)
+    size += sizes[i];
+
+  return size;
+}
+
+/* Copies @n entries, overlapping is allowed */
+static void
+gtk_btree_node_copy (GtkBTree     *tree,
+                     GtkBTreeNode *dest,
+                     guint         dest_pos,
+                     GtkBTreeNode *src,
+                     guint         src_pos,
+                     guint         n)
+{
+  if (n == 0)
+    return;
+
+  if (dest->leaf)
+    {
+      memmove (node_element (tree, dest, dest_pos),
+               node_element (tree, src, src_pos),
+               n * tree->element_size);
+    }
+  else
+    {
+      memmove (&node_children (dest)[dest_pos],
+               &node_children (src)[src_pos],
+               n * sizeof (GtkBTreeNode *));
+      memmove (&node_sizes (tree, dest)[dest_pos],
+               &node_sizes (tree, src)[src_pos],
+               n * sizeof (guint));
+      if (tree->augment_size)
+        memmove (node_augment (tree, dest, dest_pos),
+                 node_augment (tree, src, src_pos),
+                 n * tree->augment_size);
+    }
+}
+
+static void
+gtk_btree_node_clean (GtkBTree     *tree,
+                      GtkBTreeNode *node,
+                      gpointer      augment)
+{
+  node->dirty = FALSE;
+
+  if (node->leaf)
+    {
+      tree->augment_func (tree, augment, node_element (tree, node, 0), node->n_children);
+    }
+  else
+    {
+      GtkBTreeNode **children = node_children (node);
+      guint i;
+
+      for (i = 0; i < node->n_children; i++)
+        {
+          if (children[i]->dirty)
+            gtk_btree_node_clean (tree, children[i], node_augment (tree, node, i));
+        }
+
+      tree->combine_func (tree, augment, node_augment (tree, node, 0), node->n_children);
+    }
+}
+
+GtkBTree *
+gtk_btree_new_for_size (gsize               element_size,
+                        gsize               augment_size,
+                        GtkBTreeAugmentFunc augment_func,
+                        GtkBTreeCombineFunc combine_func,
+                        GDestroyNotify      clear_func)
+{
+  GtkBTree *tree;
+
+  g_return_val_if_fail (element_size > 0, NULL);
+  g_return_val_if_fail ((augment_func == NULL) == (combine_func == NULL), NULL);
+
+  tree = g_slice_new0 (GtkBTree);
+  tree->ref_count = 1;
+
+  tree->element_size = element_size;
+  tree->augment_size = augment_func ? augment_size : 0;
+  tree->augment_func = augment_func;
+  tree->combine_func = combine_func;
+  tree->clear_func = clear_func;
+
+  tree->leaf_capacity = MAX (MIN_LEAF_CAPACITY, LEAF_BYTES / element_size);
+  tree->leaf_size = HEADER_SIZE + tree->leaf_capacity * element_size;
+  tree->sizes_offset = HEADER_SIZE + (BRANCH + 1) * sizeof (GtkBTreeNode *);
+  tree->augments_offset = ALIGN (tree->sizes_offset + (BRANCH + 1) * sizeof (guint));
+  tree->inner_size = tree->augments_offset + (BRANCH + 1) * tree->augment_size;
+
+  if (tree->augment_size)
+    tree->root_augment = g_malloc0 (tree->augment_size);
+
+  return tree;
+}
+
+GtkBTree *
+gtk_btree_ref (GtkBTree *tree)
+{
+  tree->ref_count++;
+
+  return tree;
+}
+
+void
+gtk_btree_unref (GtkBTree *tree)
+{
+  tree->ref_count--;
+  if (tree->ref_count > 0)
+    return;
+
+  gtk_btree_remove_all (tree);
+  g_free (tree->root_augment);
+
+  g_slice_free (GtkBTree, tree);
+}
+
+guint
+gtk_btree_get_size (GtkBTree *tree)
+{
+  return tree->size;
+}
+
+/**
+ * gtk_btree_get:
+ * @tree: a #GtkBTree
+ * @index: index of the element
+ *
+ * Returns the element at @index. The pointer is only valid until
+ * elements are inserted into or removed from @tree.
+ *
+ * Returns: the element
+ */
+gpointer
+gtk_btree_get (GtkBTree *tree,
+               guint     index)
+{
+  GtkBTreeNode *node;
+
+  g_return_val_if_fail (index < tree->size, NULL);
+
+  node = tree->root;
+  while (!node->leaf)
+    {
+      guint *sizes = node_sizes (tree, node);
+      guint i;
+
+      for (i = 0; index >= sizes[i]; i++)
+        index -= sizes[i];
+
+      node = node_children (node)[i];
+    }
+
+  return node_element (tree, node, index);
+}
+
+/**
+ * gtk_btree_get_augment:
+ * @tree: a #GtkBTree
+ *
+ * Returns the augment for all elements of @tree.
+ *
+ * Returns: (nullable): the augment or %NULL if @tree is empty
+ */
+gpointer
+gtk_btree_get_augment (GtkBTree *tree)
+{
+  if (tree->root == NULL || tree->augment_func == NULL)
+    return NULL;
+
+  if (tree->root->dirty)
+    gtk_btree_node_clean (tree, tree->root, tree->root_augment);
+
+  return tree->root_augment;
+}
+
+/**
+ * gtk_btree_find:
+ * @tree: a #GtkBTree
+ * @find_func: function to call
+ * @user_data: data to pass to @find_func
+ *
+ * Descends into @tree to find an element. At every level,
+ * @find_func is called for the augments of the children in order
+ * until it returns %TRUE, and at the leaf it is called for the
+ * elements. @find_func is expected to track the state of the search
+ * in @user_data.
+ *
+ * Returns: the index of the element @find_func returned %TRUE for
+ *     or the size of @tree if there was none
+ */
+guint
+gtk_btree_find (GtkBTree         *tree,
+                GtkBTreeFindFunc  find_func,
+                gpointer          user_data)
+{
+  GtkBTreeNode *node;
+  guint i, index;
+
+  g_return_val_if_fail (tree->augment_func != NULL, 0);
+
+  if (tree->root == NULL)
+    return 0;
+
+  if (tree->root->dirty)
+    gtk_btree_node_clean (tree, tree->root, tree->root_augment);
+
+  node = tree->root;
+  index = 0;
+  while (!node->leaf)
+    {
+      guint *sizes = node_sizes (tree, node);
+
+      for (i = 0; i < node->n_children; i++)
+        {
+          if (find_func (tree, node_augment (tree, node, i), NULL, user_data))
+            break;
+          index += sizes[i];
+        }
+
+      if (i == node->n_children)
+        return tree->size;
+
+      node = node_children (node)[i];
+    }
+
+  for (i = 0; i < node->n_children; i++)
+    {
+      if (find_func (tree, NULL, node_element (tree, node, i), user_data))
+        return index + i;
+    }
+
+  return tree->size;
+}
+
+/**
+ * gtk_btree_mark_dirty:
+ * @tree: a #GtkBTree
+ * @index: index of the element
+ *
+ * Marks the element at @index as changed, so that the augments
+ * depending on it get updated.
+ */
+void
+gtk_btree_mark_dirty (GtkBTree *tree,
+                      guint     index)
+{
+  GtkBTreeNode *node;
+
+  g_return_if_fail (index < tree->size);
+
+  node = tree->root;
+  while (!node->leaf)
+    {
+      guint *sizes = node_sizes (tree, node);
+      guint i;
+
+      node->dirty = TRUE;
+
+      for (i = 0; index >= sizes[i]; i++)
+        index -= sizes[i];
+
+      node = node_children (node)[i];
+    }
+
+  node->dirty = TRUE;
+}
+
+/* Inserts up to @n zeroed elements at @index into a single leaf below
+ * @node and returns how many. If @node had to be split, the new node
+ * that goes after it is returned in @split. */
+static guint
+gtk_btree_node_insert (GtkBTree      *tree,
+                       GtkBTreeNode  *node,
+                       guint          index,
+                       guint          n,
+                       GtkBTreeNode **split)
+{
+  node->dirty = TRUE;
+
+  if (node->leaf)
+    {
+      GtkBTreeNode *target;
+      guint k;
+
+      target = node;
+      if (node->n_children == tree->leaf_capacity)
+        {
+          GtkBTreeNode *right;
+          guint keep;
+
+          /* Keep leaves full when appending or prepending */
+          if (index == node->n_children)
+            keep = node->n_children;
+          else if (index == 0)
+            keep = 0;
+          else
+            keep = node->n_children / 2;
+
+          right = gtk_btree_node_new (tree, TRUE);
+          gtk_btree_node_copy (tree, right, 0, node, keep, node->n_children - keep);
+          right->n_children = node->n_children - keep;
+          node->n_children = keep;
+          *split = right;
+
+          if (index > keep || keep == tree->leaf_capacity)
+            {
+              target = right;
+              index -= keep;
+            }
+        }
+
+      k = MIN (n, tree->leaf_capacity - target->n_children);
+      gtk_btree_node_copy (tree, target, index + k, target, index, target->n_children - index);
+      memset (node_element (tree, target, index), 0, k * tree->element_size);
+      target->n_children += k;
+
+      return k;
+    }
+  else
+    {
+      GtkBTreeNode **children = node_children (node);
+      guint *sizes = node_sizes (tree, node);
+      GtkBTreeNode *child_split = NULL;
+      guint i, k;
+
+      for (i = 0; i + 1 < node->n_children && index > sizes[i]; i++)
+        index -= sizes[i];
+
+      k = gtk_btree_node_insert (tree, children[i], index, n, &child_split);
+
+      if (child_split == NULL)
+        {
+          sizes[i] += k;
+          return k;
+        }
+
+      gtk_btree_node_copy (tree, node, i + 2, node, i + 1, node->n_children - i - 1);
+      children[i + 1] = child_split;
+      sizes[i] = gtk_btree_node_get_size (tree, children[i]);
+      sizes[i + 1] = gtk_btree_node_get_size (tree, child_split);
+      node->n_children++;
+
+      if (node->n_children > BRANCH)
+        {
+          GtkBTreeNode *right;
+          guint keep;
+
+          if (i + 2 == node->n_children)
+            keep = node->n_children - 1;
+          else
+            keep = node->n_children / 2;
+
+          right = gtk_btree_node_new (tree, FALSE);
+          gtk_btree_node_copy (tree, right, 0, node, keep, node->n_children - keep);
+          right->n_children = node->n_children - keep;
+          node->n_children = keep;
+          *split = right;
+        }
+
+      return k;
+    }
+}
+
+/**
+ * gtk_btree_insert:
+ * @tree: a #GtkBTree
+ * @index: where to insert
+ * @n_elements: number of elements to insert
+ *
+ * Inserts @n_elements zeroed elements at @index.
+ *
+ * Returns: the first inserted element or %NULL if none were inserted
+ */
+gpointer
+gtk_btree_insert (GtkBTree *tree,
+                  guint     index,
+                  guint     n_elements)
+{
+  guint i;
+
+  g_return_val_if_fail (index <= tree->size, NULL);
+
+  if (n_elements == 0)
+    return NULL;
+
+  if (tree->root == NULL)
+    tree->root = gtk_btree_node_new (tree, TRUE);
+
+  for (i = 0; i < n_elements;)
+    {
+      GtkBTreeNode *split = NULL;
+      guint k;
+
+      k = gtk_btree_node_insert (tree, tree->root, index + i, n_elements - i, &split);
+
+      if (split)
+        {
+          GtkBTreeNode *root = gtk_btree_node_new (tree, FALSE);
+
+          node_children (root)[0] = tree->root;
+          node_children (root)[1] = split;
+          node_sizes (tree, root)[0] = gtk_btree_node_get_size (tree, tree->root);
+          node_sizes (tree, root)[1] = gtk_btree_node_get_size (tree, split);
+          root->n_children = 2;
+          tree->root->dirty = TRUE;
+          tree->root = root;
+        }
+
+      tree->size += k;
+      i += k;
+    }
+
+  return gtk_btree_get (tree, index);
+}
+
+/* Makes sure the child at @i is not too empty by merging it with a
+ * sibling or moving entries over from it. */
+static void
+gtk_btree_node_fix_child (GtkBTree     *tree,
+                          GtkBTreeNode *node,
+                          guint         i)
+{
+  GtkBTreeNode **children = node_children (node);
+  guint *sizes = node_sizes (tree, node);
+  GtkBTreeNode *child, *left, *right;
+  guint capacity, j, total, n;
+
+  child = children[i];
+
+  if (child->n_children == 0)
+    {
+      gtk_btree_node_free (tree, child);
+      gtk_btree_node_copy (tree, node, i, node, i + 1, node->n_children - i - 1);
+      node->n_children--;
+      return;
+    }
+
+  capacity = node_capacity (tree, child);
+  if (child->n_children * 2 >= capacity || node->n_children == 1)
+    return;
+
+  j = i + 1 < node->n_children ? i : i - 1;
+  left = children[j];
+  right = children[j + 1];
+  total = left->n_children + right->n_children;
+
+  if (total <= capacity)
+    {
+      gtk_btree_node_copy (tree, left, left->n_children, right, 0, right->n_children);
+      left->n_children = total;
+      left->dirty = TRUE;
+      sizes[j] += sizes[j + 1];
+      gtk_btree_node_free (tree, right);
+      gtk_btree_node_copy (tree, node, j + 1, node, j + 2, node->n_children - j - 2);
+      node->n_children--;
+      return;
+    }
+
+  /* Too big to merge, so share the entries evenly */
+  if (left->n_children < total / 2)
+    {
+      n = total / 2 - left->n_children;
+      gtk_btree_node_copy (tree, left, left->n_children, right, 0, n);
+      gtk_btree_node_copy (tree, right, 0, right, n, right->n_children - n);
+      left->n_children += n;
+      right->n_children -= n;
+    }
+  else
+    {
+      n = left->n_children - total / 2;
+      gtk_btree_node_copy (tree, right, n, right, 0, right->n_children);
+      gtk_btree_node_copy (tree, right, 0, left, left->n_children - n, n);
+      left->n_children -= n;
+      right->n_children += n;
+    }
+  left->dirty = TRUE;
+  right->dirty = TRUE;
+  sizes[j] = gtk_btree_node_get_size (tree, left);
+  sizes[j + 1] = gtk_btree_node_get_size (tree, right);
+}
+
+/* Removes up to @n elements at @index below @node and returns how
+ * many. Only a single leaf or whole subtrees are removed. */
+static guint
+gtk_btree_node_remove (GtkBTree     *tree,
+                       GtkBTreeNode *node,
+                       guint         index,
+                       guint         n)
+{
+  node->dirty = TRUE;
+
+  if (node->leaf)
+    {
+      guint i, k;
+
+      k = MIN (n, node->n_children - index);
+      if (tree->clear_func)
+        {
+          for (i = index; i < index + k; i++)
+            tree->clear_func (node_element (tree, node, i));
+        }
+      gtk_btree_node_copy (tree, node, index, node, index + k, node->n_children - index - k);
+      node->n_children -= k;
+
+      return k;
+    }
+  else
+    {
+      GtkBTreeNode **children = node_children (node);
+      guint *sizes = node_sizes (tree, node);
+      guint i, k;
+
+      for (i = 0; index >= sizes[i]; i++)
+        index -= sizes[i];
+
+      if (index == 0 && n >= sizes[i])
+        {
+          k = sizes[i];
+          gtk_btree_node_free_deep (tree, children[i]);
+          gtk_btree_node_copy (tree, node, i, node, i + 1, node->n_children - i - 1);
+          node->n_children--;
+          return k;
+        }
+
+      k = gtk_btree_node_remove (tree, children[i], index, n);
+      sizes[i] -= k;
+      gtk_btree_node_fix_child (tree, node, i);
+
+      return k;
+    }
+}
+
+/**
+ * gtk_btree_remove:
+ * @tree: a #GtkBTree
+ * @index: index of the first element to remove
+ * @n_elements: number of elements to remove
+ *
+ * Removes @n_elements elements starting at @index.
+ */
+void
+gtk_btree_remove (GtkBTree *tree,
+                  guint     index,
+                  guint     n_elements)
+{
+  g_return_if_fail (index <= tree->size);
+  g_return_if_fail (n_elements <= tree->size - index);
+
+  while (n_elements > 0)
+    {
+      guint k;
+
+      k = gtk_btree_node_remove (tree, tree->root, index, n_elements);
+      tree->size -= k;
+      n_elements -= k;
+
+      while (!tree->root->leaf && tree->root->n_children == 1)
+        {
+          GtkBTreeNode *root = tree->root;
+
+          tree->root = node_children (root)[0];
+          tree->root->dirty = TRUE;
+          gtk_btree_node_free (tree, root);
+        }
+
+      if (tree->root->n_children == 0)
+        {
+          gtk_btree_node_free (tree, tree->root);
+          tree->root = NULL;
+        }
+    }
+}
+
+void
+gtk_btree_remove_all (GtkBTree *tree)
+{
+  if (tree->root)
+    gtk_btree_node_free_deep (tree, tree->root);
+
+  tree->root = NULL;
+  tree->size = 0;
+}
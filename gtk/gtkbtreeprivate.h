@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2018 Benjamin Otte
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* A counted B+tree storing a sequence of fixed-size elements.
+ *
+ * Unlike GtkRbTree, elements are stored in arrays inside the leaves,
+ * so pointers to them are only valid until the tree is modified.
+ * Elements are addressed by their index instead.
+ */
+#ifndef __GTK_BTREE_H__
+#define __GTK_BTREE_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+
+typedef struct _GtkBTree GtkBTree;
+
+/* Computes the augment for @n_elements consecutive elements */
+typedef void            (* GtkBTreeAugmentFunc)         (GtkBTree                *tree,
+                                                         gpointer                 augment,
+                                                         gpointer                 elements,
+                                                         guint                    n_elements);
+/* Computes the augment for @n_augments consecutive augments */
+typedef void            (* GtkBTreeCombineFunc)         (GtkBTree                *tree,
+                                                         gpointer                 augment,
+                                                         gpointer                 augments,
+                                                         guint                    n_augments);
+/* Called with either an @augment or an @element, in order.
+ * Returns %TRUE if the element searched for is inside. */
+typedef gboolean        (* GtkBTreeFindFunc)            (GtkBTree                *tree,
+                                                         gpointer                 augment,
+                                                         gpointer                 element,
+                                                         gpointer                 user_data);
+
+GtkBTree *           gtk_btree_new_for_size             (gsize                    element_size,
+                                                         gsize                    augment_size,
+                                                         GtkBTreeAugmentFunc      augment_func,
+                                                         GtkBTreeCombineFunc      combine_func,
+                                                         GDestroyNotify           clear_func);
+#define gtk_btree_new(type, augment_type, augment_func, combine_func, clear_func) \
+  gtk_btree_new_for_size (sizeof (type), sizeof (augment_type), (augment_func), (combine_func), (clear_func))
+
+GtkBTree *           gtk_btree_ref                      (GtkBTree                *tree);
+void                 gtk_btree_unref                    (GtkBTree                *tree);
+
+guint                gtk_btree_get_size                 (GtkBTree                *tree);
+gpointer             gtk_btree_get                      (GtkBTree                *tree,
+                                                         guint                    index);
+gpointer             gtk_btree_get_augment              (GtkBTree                *tree);
+guint                gtk_btree_find                     (GtkBTree                *tree,
+                                                         GtkBTreeFindFunc         find_func,
+                                                         gpointer                 user_data);
+void                 gtk_btree_mark_dirty               (GtkBTree                *tree,
+                                                         guint                    index);
+
+gpointer             gtk_btree_insert                   (GtkBTree                *tree,
+                                                         guint                    index,
+                                                         guint                    n_elements);
+void                 gtk_btree_remove                   (GtkBTree                *tree,
+                                                         guint                    index,
+                                                         guint                    n_elements);
+void                 gtk_btree_remove_all               (GtkBTree                *tree);
+
+
+G_END_DECLS
+
+
+#endif /* __GTK_BTREE_H__ */
@@ -348,6 +348,7 @@
 #include "gtkintl.h"
 #include "gtkcelllayout.h"
 #include "gtkcellarea.h"
+#include "gtkcellareabox.h"
 #include "gtkcellareacontext.h"
 #include "gtkmarshalers.h"
 #include "gtkprivate.h"
@@ -3574,3 +3575,53 @@ _gtk_cell_area_set_cell_data_func_with_proxy (GtkCellArea           *area,
       g_hash_table_insert (priv->cell_info, cell, info);
     }
 }
+
+/* Used by GtkTreeViewColumn to cache sizes by row content.
+ *
+ * Collects the model columns that the attributes of @area are bound to
+ * into @columns and sets @layout_hash to a value that changes when the
+ * attributes change. Returns %FALSE if the cells might get data from
+ * somewhere else, like cell data functions.
+ */
+gboolean
+_gtk_cell_area_get_attribute_columns (GtkCellArea *area,
+                                      GArray      *columns,
+                                      guint       *layout_hash)
+{
+  GtkCellAreaPrivate *priv;
+  GHashTableIter      iter;
+  gpointer            renderer, value;
+
+  g_return_val_if_fail (GTK_IS_CELL_AREA (area), FALSE);
+
+  priv = area->priv;
+
+  /* Subclasses and signal handlers could apply anything */
+  if (G_OBJECT_TYPE (area) != GTK_TYPE_CELL_AREA_BOX ||
+      g_signal_has_handler_pending (area, cell_area_signals[SIGNAL_APPLY_ATTRIBUTES], 0, FALSE))
+    return FALSE;
+
+  *layout_hash = 0;
+
+  g_hash_table_iter_init (&iter, priv->cell_info);
+  while (g_hash_table_iter_next (&iter, &renderer, &value))
+    {
+      CellInfo *info = value;
+      GSList   *l;
+
+      if (info->func)
+        return FALSE;
+
+      for (l = info->attributes; l; l = l->next)
+        {
+          CellAttribute *attribute = l->data;
+
+          g_array_append_val (columns, attribute->column);
+
+          /* Independent of the order of the hash table */
+          *layout_hash += (g_direct_hash (renderer) * 31 + g_direct_hash (attribute->attribute)) * 31 + attribute->column;
+        }
+    }
+
+  return TRUE;
+}
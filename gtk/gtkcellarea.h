@@ -529,6 +529,10 @@ void                 _gtk_cell_area_set_cell_data_func_with_proxy  (GtkCellArea
 								    GDestroyNotify         destroy,
 								    gpointer               proxy);
 
+gboolean             _gtk_cell_area_get_attribute_columns          (GtkCellArea           *area,
+                                                                    GArray                *columns,
+                                                                    guint                 *layout_hash);
+
 G_END_DECLS
 
 #endif /* __GTK_CELL_AREA_H__ */
@@ -91,6 +91,8 @@ gtk_css_animated_style_dispose (GObject *object)
       style->animated_values = NULL;
     }
 
+  g_clear_pointer (&style->animated_properties, _gtk_bitmask_free);
+
   g_slist_free_full (style->animations, g_object_unref);
   style->animations = NULL;
 
@@ -124,6 +126,7 @@ gtk_css_animated_style_class_init (GtkCssAnimatedStyleClass *klass)
 static void
 gtk_css_animated_style_init (GtkCssAnimatedStyle *style)
 {
+  style->animated_properties = _gtk_bitmask_new ();
 }
 
 void
@@ -143,6 +146,7 @@ gtk_css_animated_style_set_animated_value (GtkCssAnimatedStyle *style,
     _gtk_css_value_unref (g_ptr_array_index (style->animated_values, id));
   g_ptr_array_index (style->animated_values, id) = _gtk_css_value_ref (value);
 
+  style->animated_properties = _gtk_bitmask_set (style->animated_properties, id, TRUE);
 }
 
 GtkCssValue *
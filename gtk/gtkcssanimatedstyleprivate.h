@@ -41,6 +41,7 @@ struct _GtkCssAnimatedStyle
   GtkCssStyle           *style;                /* the style if we weren't animating */
 
   GPtrArray             *animated_values;      /* NULL or array of animated values/NULL if not animated */
+  GtkBitmask            *animated_properties;  /* ids of the properties set in animated_values */
   gint64                 current_time;         /* the current time in our world */
   GSList                *animations;           /* the running animations, least important one first */
 };
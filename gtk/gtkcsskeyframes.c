@@ -27,6 +27,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+typedef struct _GtkCssKeyframeStop GtkCssKeyframeStop;
+
+struct _GtkCssKeyframeStop {
+  double progress;
+  GtkCssValue *value;           /* owned by the values array */
+};
+
 struct _GtkCssKeyframes {
   int ref_count;                /* ref count */
   int n_keyframes;              /* number of keyframes (at least 2 for 0% and 100% */
@@ -34,6 +41,8 @@ struct _GtkCssKeyframes {
   int n_properties;             /* number of properties used by keyframes */
   guint *property_ids;          /* ordered array of n_properties property ids */
   GtkCssValue **values;         /* 2D array: n_keyframes * n_properties of (value or NULL) for all the keyframes */
+  guint *track_offsets;         /* NULL or n_properties + 1 offsets into stops */
+  GtkCssKeyframeStop *stops;    /* the set values of each property, ordered by progress */
 };
 
 #define KEYFRAMES_VALUE(keyframes, k, p) ((keyframes)->values[(k) * (keyframes)->n_properties + (p)])
@@ -61,6 +70,8 @@ _gtk_css_keyframes_unref (GtkCssKeyframes *keyframes)
 
   g_free (keyframes->keyframe_progress);
   g_free (keyframes->property_ids);
+  g_free (keyframes->track_offsets);
+  g_free (keyframes->stops);
 
   for (k = 0; k < keyframes->n_keyframes; k++)
     {
@@ -434,6 +445,36 @@ _gtk_css_keyframes_print (GtkCssKeyframes *keyframes,
   g_free (sorted);
 }
 
+/* Computed keyframes are evaluated on every frame of an animation,
+ * so collect the set values of every property into a track that
+ * can be searched without looking at the holes of the values array.
+ */
+static void
+gtk_css_keyframes_resolve_tracks (GtkCssKeyframes *keyframes)
+{
+  guint k, p, n_stops;
+
+  keyframes->track_offsets = g_new (guint, keyframes->n_properties + 1);
+  keyframes->stops = g_new (GtkCssKeyframeStop, keyframes->n_keyframes * keyframes->n_properties);
+
+  n_stops = 0;
+  for (p = 0; p < keyframes->n_properties; p++)
+    {
+      keyframes->track_offsets[p] = n_stops;
+
+      for (k = 0; k < keyframes->n_keyframes; k++)
+        {
+          if (KEYFRAMES_VALUE (keyframes, k, p) == NULL)
+            continue;
+
+          keyframes->stops[n_stops].progress = keyframes->keyframe_progress[k];
+          keyframes->stops[n_stops].value = KEYFRAMES_VALUE (keyframes, k, p);
+          n_stops++;
+        }
+    }
+  keyframes->track_offsets[p] = n_stops;
+}
+
 GtkCssKeyframes *
 _gtk_css_keyframes_compute (GtkCssKeyframes  *keyframes,
                             GtkStyleProvider *provider,
@@ -470,6 +511,8 @@ _gtk_css_keyframes_compute (GtkCssKeyframes  *keyframes,
         }
     }
 
+  gtk_css_keyframes_resolve_tracks (resolved);
+
   return resolved;
 }
 
@@ -509,25 +552,65 @@ _gtk_css_keyframes_get_value (GtkCssKeyframes *keyframes,
   end_value = default_value;
   end_progress = 1.0;
 
-  for (k = 0; k < keyframes->n_keyframes; k++)
+  if (keyframes->track_offsets)
     {
-      if (KEYFRAMES_VALUE (keyframes, k, id) == NULL)
-        continue;
+      const GtkCssKeyframeStop *stops = &keyframes->stops[keyframes->track_offsets[id]];
+      guint n_stops = keyframes->track_offsets[id + 1] - keyframes->track_offsets[id];
+      guint min, max;
+
+      /* find the first stop at or after progress */
+      min = 0;
+      max = n_stops;
+      while (min < max)
+        {
+          guint mid = (min + max) / 2;
 
-      if (keyframes->keyframe_progress[k] == progress)
+          if (stops[mid].progress < progress)
+            min = mid + 1;
+          else
+            max = mid;
+        }
+
+      if (min < n_stops)
         {
-          return _gtk_css_value_ref (KEYFRAMES_VALUE (keyframes, k, id));
+          if (stops[min].progress == progress)
+            return _gtk_css_value_ref (stops[min].value);
+
+          end_value = stops[min].value;
+          end_progress = stops[min].progress;
         }
-      else if (keyframes->keyframe_progress[k] < progress)
+      if (min > 0)
         {
-          start_value = KEYFRAMES_VALUE (keyframes, k, id);
-          start_progress = keyframes->keyframe_progress[k];
+          start_value = stops[min - 1].value;
+          start_progress = stops[min - 1].progress;
         }
-      else
+
+      /* computed values are interned, so holds are cheap to detect */
+      if (start_value == end_value)
+        return _gtk_css_value_ref (start_value);
+    }
+  else
+    {
+      for (k = 0; k < keyframes->n_keyframes; k++)
         {
-          end_value = KEYFRAMES_VALUE (keyframes, k, id);
-          end_progress = keyframes->keyframe_progress[k];
-          break;
+          if (KEYFRAMES_VALUE (keyframes, k, id) == NULL)
+            continue;
+
+          if (keyframes->keyframe_progress[k] == progress)
+            {
+              return _gtk_css_value_ref (KEYFRAMES_VALUE (keyframes, k, id));
+            }
+          else if (keyframes->keyframe_progress[k] < progress)
+            {
+              start_value = KEYFRAMES_VALUE (keyframes, k, id);
+              start_progress = keyframes->keyframe_progress[k];
+            }
+          else
+            {
+              end_value = KEYFRAMES_VALUE (keyframes, k, id);
+              end_progress = keyframes->keyframe_progress[k];
+              break;
+            }
         }
     }
 
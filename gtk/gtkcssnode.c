@@ -20,11 +20,13 @@
 #include "gtkcssnodeprivate.h"
 
 #include "gtkcssanimatedstyleprivate.h"
+#include "gtkcssprofilerprivate.h"
 #include "gtkcsssectionprivate.h"
 #include "gtkcssstylepropertyprivate.h"
 #include "gtkintl.h"
 #include "gtkmarshalers.h"
 #include "gtksettingsprivate.h"
+#include "gtkstyleproviderprivate.h"
 #include "gtktypebuiltins.h"
 
 /*
@@ -990,6 +992,9 @@ gtk_css_node_ensure_style (GtkCssNode *cssnode,
 
       g_clear_pointer (&cssnode->cache, gtk_css_node_style_cache_unref);
 
+      if (G_UNLIKELY (gtk_css_profiler_get_enabled ()))
+        gtk_css_profiler_count_node_restyle (cssnode->pending_changes);
+
       new_style = GTK_CSS_NODE_GET_CLASS (cssnode)->update_style (cssnode,
                                                                   cssnode->pending_changes,
                                                                   current_time,
@@ -1249,12 +1254,34 @@ gtk_css_node_get_declaration (GtkCssNode *cssnode)
   return cssnode->decl;
 }
 
+static gboolean
+gtk_css_node_is_affected_by_provider_change (GtkCssNode *cssnode)
+{
+  GtkCssMatcher matcher;
+
+  if (!gtk_style_provider_change_is_filtered ())
+    return TRUE;
+
+  if (!gtk_css_node_init_matcher (cssnode, &matcher))
+    return TRUE;
+
+  return gtk_style_provider_change_may_affect (&matcher);
+}
+
 void
 gtk_css_node_invalidate_style_provider (GtkCssNode *cssnode)
 {
   GtkCssNode *child;
 
-  gtk_css_node_invalidate (cssnode, GTK_CSS_CHANGE_SOURCE);
+  if (gtk_css_node_is_affected_by_provider_change (cssnode))
+    {
+      /* The parent may not get restyled, so make sure we don't
+       * pick up a stale style from its cache. */
+      if (cssnode->parent)
+        g_clear_pointer (&cssnode->parent->cache, gtk_css_node_style_cache_unref);
+
+      gtk_css_node_invalidate (cssnode, GTK_CSS_CHANGE_SOURCE);
+    }
 
   for (child = cssnode->first_child;
        child;
@@ -1346,10 +1373,17 @@ void
 gtk_css_node_validate (GtkCssNode *cssnode)
 {
   gint64 timestamp;
+  gint64 start_time = 0;
 
   timestamp = gtk_css_node_get_timestamp (cssnode);
 
+  if (G_UNLIKELY (gtk_css_profiler_get_enabled ()))
+    start_time = g_get_monotonic_time ();
+
   gtk_css_node_validate_internal (cssnode, timestamp);
+
+  if (G_UNLIKELY (gtk_css_profiler_get_enabled ()))
+    gtk_css_profiler_count_restyle (g_get_monotonic_time () - start_time);
 }
 
 gboolean
@@ -413,13 +413,65 @@ _gtk_css_parser_get_ident (GtkCssParser *parser)
   return result;
 }
 
-char *
-_gtk_css_parser_try_name (GtkCssParser *parser,
-                          gboolean      skip_whitespace)
+/* Most names in style sheets are plain ASCII without escapes. For
+ * those, returns the length of the name at the current position so
+ * it can be used straight from the input. Returns 0 if the slow path
+ * that handles escapes and errors needs to be taken.
+ */
+static gsize
+gtk_css_parser_get_plain_name_length (GtkCssParser *parser,
+                                      gboolean      ident)
 {
-  GString *name;
+  const char *p = parser->data;
 
-  g_return_val_if_fail (GTK_IS_CSS_PARSER (parser), NULL);
+  if (ident)
+    {
+      if (*p == '-')
+        p++;
+      if (!g_ascii_isalpha (*p))
+        return 0;
+    }
+
+  while (g_ascii_isalnum (*p) || *p == '-' || *p == '_')
+    p++;
+
+  /* These would be consumed by _gtk_css_parser_read_char() */
+  if (*p == '\\' || *p >= 127)
+    return 0;
+
+  return p - parser->data;
+}
+
+static const char *
+gtk_css_parser_intern_plain_name (GtkCssParser *parser,
+                                  gsize         len)
+{
+  const char *result;
+  char buf[64];
+
+  if (len < sizeof (buf))
+    {
+      memcpy (buf, parser->data, len);
+      buf[len] = 0;
+      result = g_intern_string (buf);
+    }
+  else
+    {
+      char *s = g_strndup (parser->data, len);
+      result = g_intern_string (s);
+      g_free (s);
+    }
+
+  parser->data += len;
+
+  return result;
+}
+
+static char *
+gtk_css_parser_try_name_slow (GtkCssParser *parser,
+                              gboolean      skip_whitespace)
+{
+  GString *name;
 
   if (parser->ident_str == NULL)
     parser->ident_str = g_string_new (NULL);
@@ -436,14 +488,64 @@ _gtk_css_parser_try_name (GtkCssParser *parser,
 }
 
 char *
-_gtk_css_parser_try_ident (GtkCssParser *parser,
-                           gboolean      skip_whitespace)
+_gtk_css_parser_try_name (GtkCssParser *parser,
+                          gboolean      skip_whitespace)
 {
-  const char *start;
-  GString *ident;
+  char *result;
+  gsize len;
+
+  g_return_val_if_fail (GTK_IS_CSS_PARSER (parser), NULL);
+
+  len = gtk_css_parser_get_plain_name_length (parser, FALSE);
+  if (len == 0)
+    return gtk_css_parser_try_name_slow (parser, skip_whitespace);
+
+  result = g_strndup (parser->data, len);
+  parser->data += len;
+
+  if (skip_whitespace)
+    _gtk_css_parser_skip_whitespace (parser);
+
+  return result;
+}
+
+/* Like _gtk_css_parser_try_name(), but returns an interned string.
+ * This avoids allocating for names that are interned anyway, like
+ * the ones used in selectors. */
+const char *
+_gtk_css_parser_try_name_intern (GtkCssParser *parser,
+                                 gboolean      skip_whitespace)
+{
+  const char *result;
+  char *name;
+  gsize len;
 
   g_return_val_if_fail (GTK_IS_CSS_PARSER (parser), NULL);
 
+  len = gtk_css_parser_get_plain_name_length (parser, FALSE);
+  if (len == 0)
+    {
+      name = gtk_css_parser_try_name_slow (parser, skip_whitespace);
+      result = g_intern_string (name);
+      g_free (name);
+      return result;
+    }
+
+  result = gtk_css_parser_intern_plain_name (parser, len);
+
+  if (skip_whitespace)
+    _gtk_css_parser_skip_whitespace (parser);
+
+  return result;
+}
+
+static char *
+gtk_css_parser_try_ident_slow (GtkCssParser *parser,
+                               gboolean      skip_whitespace)
+{
+  const char *start;
+  GString *ident;
+
   start = parser->data;
   
   if (parser->ident_str == NULL)
@@ -473,6 +575,59 @@ _gtk_css_parser_try_ident (GtkCssParser *parser,
   return _gtk_css_parser_get_ident (parser);
 }
 
+char *
+_gtk_css_parser_try_ident (GtkCssParser *parser,
+                           gboolean      skip_whitespace)
+{
+  char *result;
+  gsize len;
+
+  g_return_val_if_fail (GTK_IS_CSS_PARSER (parser), NULL);
+
+  len = gtk_css_parser_get_plain_name_length (parser, TRUE);
+  if (len == 0)
+    return gtk_css_parser_try_ident_slow (parser, skip_whitespace);
+
+  result = g_strndup (parser->data, len);
+  parser->data += len;
+
+  if (skip_whitespace)
+    _gtk_css_parser_skip_whitespace (parser);
+
+  return result;
+}
+
+/* Like _gtk_css_parser_try_ident(), but returns an interned string. */
+const char *
+_gtk_css_parser_try_ident_intern (GtkCssParser *parser,
+                                  gboolean      skip_whitespace)
+{
+  const char *result;
+  char *ident;
+  gsize len;
+
+  g_return_val_if_fail (GTK_IS_CSS_PARSER (parser), NULL);
+
+  len = gtk_css_parser_get_plain_name_length (parser, TRUE);
+  if (len == 0)
+    {
+      ident = gtk_css_parser_try_ident_slow (parser, skip_whitespace);
+      if (ident == NULL)
+        return NULL;
+
+      result = g_intern_string (ident);
+      g_free (ident);
+      return result;
+    }
+
+  result = gtk_css_parser_intern_plain_name (parser, len);
+
+  if (skip_whitespace)
+    _gtk_css_parser_skip_whitespace (parser);
+
+  return result;
+}
+
 gboolean
 _gtk_css_parser_is_string (GtkCssParser *parser)
 {
@@ -499,6 +654,20 @@ _gtk_css_parser_read_string (GtkCssParser *parser)
   
   parser->data++;
 
+  /* Fast path for strings without escapes */
+  {
+    gsize len = strcspn (parser->data, "\\'\"\n\r\f");
+
+    if (parser->data[len] == quote)
+      {
+        char *result = g_strndup (parser->data, len);
+
+        parser->data += len + 1;
+        _gtk_css_parser_skip_whitespace (parser);
+        return result;
+      }
+  }
+
   if (parser->ident_str == NULL)
     parser->ident_str = g_string_new (NULL);
 
@@ -0,0 +1,306 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtkcssprofilerprivate.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Collects statistics about the style machinery: how often selectors
+ * are tried and match, how long restyles take and why nodes get
+ * restyled.
+ *
+ * Profiling is off by default. It can be turned on from the inspector
+ * or by setting GTK_CSS_PROFILE to the name of a file that the
+ * statistics are written to in JSON format when the process exits.
+ */
+
+#define N_CHANGE_BITS 64
+
+typedef struct _SelectorStats SelectorStats;
+
+struct _SelectorStats {
+  char *name;
+  guint64 attempts;
+  guint64 hits;
+};
+
+/* Not static so that gtk_css_profiler_get_enabled() can be inlined
+ * into the selector matching code */
+gboolean gtk_css_profiler_enabled = FALSE;
+static char *profile_filename = NULL;
+
+/* name => SelectorStats */
+static GHashTable *selector_stats = NULL;
+/* key => SelectorStats, owned by selector_stats */
+static GHashTable *selector_keys = NULL;
+
+static guint64 n_restyles = 0;
+static gint64 restyle_time = 0;
+static gint64 max_restyle_time = 0;
+
+static guint64 n_node_restyles = 0;
+static guint64 node_restyles_per_change[N_CHANGE_BITS];
+
+static void
+selector_stats_free (gpointer data)
+{
+  SelectorStats *stats = data;
+
+  g_free (stats->name);
+  g_slice_free (SelectorStats, stats);
+}
+
+static void
+gtk_css_profiler_write_profile (void)
+{
+  GError *error = NULL;
+  char *profile;
+
+  profile = gtk_css_profiler_to_string ();
+
+  if (!g_file_set_contents (profile_filename, profile, -1, &error))
+    {
+      g_warning ("Failed to write CSS profile to %s: %s", profile_filename, error->message);
+      g_error_free (error);
+    }
+
+  g_free (profile);
+}
+
+void
+gtk_css_profiler_init_from_env (void)
+{
+  const char *env;
+
+  env = g_getenv ("GTK_CSS_PROFILE");
+  if (env == NULL || env[0] == '\0' || profile_filename != NULL)
+    return;
+
+  profile_filename = g_strdup (env);
+  gtk_css_profiler_set_enabled (TRUE);
+
+  atexit (gtk_css_profiler_write_profile);
+}
+
+void
+gtk_css_profiler_set_enabled (gboolean enabled)
+{
+  gtk_css_profiler_enabled = enabled;
+
+  if (enabled && selector_stats == NULL)
+    {
+      selector_stats = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, selector_stats_free);
+      selector_keys = g_hash_table_new (NULL, NULL);
+    }
+}
+
+void
+gtk_css_profiler_reset (void)
+{
+  if (selector_stats)
+    {
+      g_hash_table_remove_all (selector_keys);
+      g_hash_table_remove_all (selector_stats);
+    }
+
+  n_restyles = 0;
+  restyle_time = 0;
+  max_restyle_time = 0;
+
+  n_node_restyles = 0;
+  memset (node_restyles_per_change, 0, sizeof (node_restyles_per_change));
+}
+
+void
+gtk_css_profiler_count_selector (gconstpointer           key,
+                                 GtkCssProfilerPrintFunc print_func,
+                                 gboolean                matched)
+{
+  SelectorStats *stats;
+
+  if (!gtk_css_profiler_enabled)
+    return;
+
+  stats = g_hash_table_lookup (selector_keys, key);
+  if (stats == NULL)
+    {
+      GString *name = g_string_new (NULL);
+
+      print_func (key, name);
+
+      stats = g_hash_table_lookup (selector_stats, name->str);
+      if (stats == NULL)
+        {
+          stats = g_slice_new0 (SelectorStats);
+          stats->name = g_string_free (name, FALSE);
+          g_hash_table_insert (selector_stats, stats->name, stats);
+        }
+      else
+        g_string_free (name, TRUE);
+
+      g_hash_table_insert (selector_keys, (gpointer) key, stats);
+    }
+
+  stats->attempts++;
+  if (matched)
+    stats->hits++;
+}
+
+/* Must be called when keys passed to gtk_css_profiler_count_selector()
+ * become invalid, the collected numbers are kept. */
+void
+gtk_css_profiler_forget_selectors (void)
+{
+  if (selector_keys)
+    g_hash_table_remove_all (selector_keys);
+}
+
+void
+gtk_css_profiler_count_restyle (gint64 duration)
+{
+  if (!gtk_css_profiler_enabled)
+    return;
+
+  n_restyles++;
+  restyle_time += duration;
+  max_restyle_time = MAX (max_restyle_time, duration);
+}
+
+void
+gtk_css_profiler_count_node_restyle (GtkCssChange change)
+{
+  guint i;
+
+  if (!gtk_css_profiler_enabled)
+    return;
+
+  n_node_restyles++;
+
+  for (i = 0; i < N_CHANGE_BITS; i++)
+    {
+      if (change & (((GtkCssChange) 1) << i))
+        node_restyles_per_change[i]++;
+    }
+}
+
+static void
+print_json_string (GString    *string,
+                   const char *s)
+{
+  g_string_append_c (string, '"');
+  for (; *s; s++)
+    {
+      if (*s == '"' || *s == '\\')
+        g_string_append_c (string, '\\');
+      g_string_append_c (string, *s);
+    }
+  g_string_append_c (string, '"');
+}
+
+static int
+compare_selector_stats (gconstpointer a,
+                        gconstpointer b)
+{
+  const SelectorStats *sa = *(const SelectorStats **) a;
+  const SelectorStats *sb = *(const SelectorStats **) b;
+
+  if (sa->attempts != sb->attempts)
+    return sa->attempts > sb->attempts ? -1 : 1;
+
+  return strcmp (sa->name, sb->name);
+}
+
+void
+gtk_css_profiler_print (GString *string)
+{
+  GPtrArray *selectors;
+  gboolean first;
+  guint i;
+
+  g_string_append (string, "{\n");
+
+  g_string_append_printf (string,
+                          "  \"restyles\": { \"count\": %" G_GUINT64_FORMAT ", "
+                          "\"total-usec\": %" G_GINT64_FORMAT ", "
+                          "\"max-usec\": %" G_GINT64_FORMAT " },\n",
+                          n_restyles, restyle_time, max_restyle_time);
+
+  g_string_append_printf (string,
+                          "  \"node-restyles\": { \"total\": %" G_GUINT64_FORMAT,
+                          n_node_restyles);
+  for (i = 0; i < N_CHANGE_BITS; i++)
+    {
+      GString *name;
+
+      if (node_restyles_per_change[i] == 0)
+        continue;
+
+      name = g_string_new (NULL);
+      gtk_css_change_print (((GtkCssChange) 1) << i, name);
+      if (name->len > 0)
+        {
+          g_string_append (string, ", ");
+          print_json_string (string, name->str);
+          g_string_append_printf (string, ": %" G_GUINT64_FORMAT, node_restyles_per_change[i]);
+        }
+      g_string_free (name, TRUE);
+    }
+  g_string_append (string, " },\n");
+
+  g_string_append (string, "  \"selectors\": [");
+  selectors = g_ptr_array_new ();
+  if (selector_stats)
+    {
+      GHashTableIter iter;
+      gpointer value;
+
+      g_hash_table_iter_init (&iter, selector_stats);
+      while (g_hash_table_iter_next (&iter, NULL, &value))
+        g_ptr_array_add (selectors, value);
+    }
+  g_ptr_array_sort (selectors, compare_selector_stats);
+
+  first = TRUE;
+  for (i = 0; i < selectors->len; i++)
+    {
+      SelectorStats *stats = g_ptr_array_index (selectors, i);
+
+      g_string_append (string, first ? "\n    { \"selector\": " : ",\n    { \"selector\": ");
+      print_json_string (string, stats->name);
+      g_string_append_printf (string,
+                              ", \"attempts\": %" G_GUINT64_FORMAT ", \"hits\": %" G_GUINT64_FORMAT " }",
+                              stats->attempts, stats->hits);
+      first = FALSE;
+    }
+  g_ptr_array_free (selectors, TRUE);
+
+  g_string_append (string, first ? "]\n" : "\n  ]\n");
+  g_string_append (string, "}\n");
+}
+
+char *
+gtk_css_profiler_to_string (void)
+{
+  GString *string = g_string_new (NULL);
+
+  gtk_css_profiler_print (string);
+
+  return g_string_free (string, FALSE);
+}
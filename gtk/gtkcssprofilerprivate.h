@@ -0,0 +1,54 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GTK_CSS_PROFILER_PRIVATE_H__
+#define __GTK_CSS_PROFILER_PRIVATE_H__
+
+#include "gtkcsstypesprivate.h"
+
+G_BEGIN_DECLS
+
+typedef void (* GtkCssProfilerPrintFunc) (gconstpointer  key,
+                                          GString       *string);
+
+extern gboolean gtk_css_profiler_enabled;
+
+void            gtk_css_profiler_init_from_env          (void);
+
+/* Called on every selector match, so this must be cheap */
+static inline gboolean
+gtk_css_profiler_get_enabled (void)
+{
+  return gtk_css_profiler_enabled;
+}
+
+void            gtk_css_profiler_set_enabled            (gboolean                 enabled);
+void            gtk_css_profiler_reset                  (void);
+
+void            gtk_css_profiler_count_selector         (gconstpointer            key,
+                                                         GtkCssProfilerPrintFunc  print_func,
+                                                         gboolean                 matched);
+void            gtk_css_profiler_forget_selectors       (void);
+void            gtk_css_profiler_count_restyle          (gint64                   duration);
+void            gtk_css_profiler_count_node_restyle     (GtkCssChange             change);
+
+void            gtk_css_profiler_print                  (GString                 *string);
+char *          gtk_css_profiler_to_string              (void);
+
+G_END_DECLS
+
+#endif /* __GTK_CSS_PROFILER_PRIVATE_H__ */
@@ -78,6 +78,7 @@
 
 
 typedef struct GtkCssRuleset GtkCssRuleset;
+typedef struct _GtkCssRules GtkCssRules;
 typedef struct _GtkCssScanner GtkCssScanner;
 typedef struct _PropertyValue PropertyValue;
 typedef enum ParserScope ParserScope;
@@ -96,15 +97,28 @@ struct GtkCssRuleset
   PropertyValue *styles;
   GtkBitmask *set_styles;
   guint n_styles;
+  guint specificity;
+  guint origin;
   guint owns_styles : 1;
 };
 
+/* Rules added with gtk_css_provider_add_rules(), they have their
+ * own selector tree so they can be added and removed without
+ * touching the rest of the provider. */
+struct _GtkCssRules
+{
+  guint id;
+  GArray *rulesets;
+  GtkCssSelectorTree *tree;
+};
+
 struct _GtkCssScanner
 {
   GtkCssProvider *provider;
   GtkCssParser *parser;
   GtkCssSection *section;
   GtkCssScanner *parent;
+  GArray *rulesets;
   GSList *state;
 };
 
@@ -117,6 +131,8 @@ struct _GtkCssProviderPrivate
 
   GArray *rulesets;
   GtkCssSelectorTree *tree;
+  GPtrArray *rules;
+  guint last_rules_id;
   GResource *resource;
   gchar *path;
 };
@@ -267,6 +283,20 @@ gtk_css_ruleset_clear (GtkCssRuleset *ruleset)
   memset (ruleset, 0, sizeof (GtkCssRuleset));
 }
 
+static void
+gtk_css_rules_free (GtkCssRules *rules)
+{
+  guint i;
+
+  for (i = 0; i < rules->rulesets->len; i++)
+    gtk_css_ruleset_clear (&g_array_index (rules->rulesets, GtkCssRuleset, i));
+
+  g_array_free (rules->rulesets, TRUE);
+  _gtk_css_selector_tree_free (rules->tree);
+
+  g_slice_free (GtkCssRules, rules);
+}
+
 static void
 gtk_css_ruleset_add (GtkCssRuleset       *ruleset,
                      GtkCssStyleProperty *property,
@@ -358,6 +388,7 @@ gtk_css_scanner_new (GtkCssProvider *provider,
                      GFile          *file,
                      const gchar    *text)
 {
+  GtkCssProviderPrivate *priv = gtk_css_provider_get_instance_private (provider);
   GtkCssScanner *scanner;
 
   scanner = g_slice_new0 (GtkCssScanner);
@@ -365,6 +396,10 @@ gtk_css_scanner_new (GtkCssProvider *provider,
   g_object_ref (provider);
   scanner->provider = provider;
   scanner->parent = parent;
+  if (parent)
+    scanner->rulesets = parent->rulesets;
+  else
+    scanner->rulesets = priv->rulesets;
   if (section)
     scanner->section = gtk_css_section_ref (section);
 
@@ -431,6 +466,7 @@ gtk_css_provider_init (GtkCssProvider *css_provider)
   GtkCssProviderPrivate *priv = gtk_css_provider_get_instance_private (css_provider);
 
   priv->rulesets = g_array_new (FALSE, FALSE, sizeof (GtkCssRuleset));
+  priv->rules = g_ptr_array_new_with_free_func ((GDestroyNotify) gtk_css_rules_free);
 
   priv->symbolic_colors = g_hash_table_new_full (g_str_hash, g_str_equal,
                                                  (GDestroyNotify) g_free,
@@ -553,6 +589,60 @@ gtk_css_style_provider_get_keyframes (GtkStyleProvider *provider,
   return g_hash_table_lookup (priv->keyframes, name);
 }
 
+static int
+gtk_css_ruleset_compare_precedence (gconstpointer a_,
+                                    gconstpointer b_)
+{
+  const GtkCssRuleset *a = *(const GtkCssRuleset **) a_;
+  const GtkCssRuleset *b = *(const GtkCssRuleset **) b_;
+
+  if (a->specificity != b->specificity)
+    return a->specificity < b->specificity ? -1 : 1;
+
+  if (a->origin != b->origin)
+    return a->origin < b->origin ? -1 : 1;
+
+  /* rulesets of the same origin live in the same array */
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static GPtrArray *
+gtk_css_provider_match_added_rules (GtkCssProvider      *css_provider,
+                                    const GtkCssMatcher *matcher,
+                                    GPtrArray           *tree_rules)
+{
+  GtkCssProviderPrivate *priv = gtk_css_provider_get_instance_private (css_provider);
+  gboolean needs_sort = FALSE;
+  guint i, j;
+
+  for (i = 0; i < priv->rules->len; i++)
+    {
+      GtkCssRules *rules = g_ptr_array_index (priv->rules, i);
+      GPtrArray *matches;
+
+      matches = _gtk_css_selector_tree_match_all (rules->tree, matcher);
+      if (matches == NULL)
+        continue;
+
+      if (tree_rules == NULL)
+        {
+          tree_rules = matches;
+          continue;
+        }
+
+      for (j = 0; j < matches->len; j++)
+        g_ptr_array_add (tree_rules, g_ptr_array_index (matches, j));
+      g_ptr_array_free (matches, TRUE);
+      needs_sort = TRUE;
+    }
+
+  /* Matches from different trees need to be merged by precedence */
+  if (needs_sort)
+    g_ptr_array_sort (tree_rules, gtk_css_ruleset_compare_precedence);
+
+  return tree_rules;
+}
+
 static void
 gtk_css_style_provider_lookup (GtkStyleProvider    *provider,
                                const GtkCssMatcher *matcher,
@@ -568,9 +658,13 @@ gtk_css_style_provider_lookup (GtkStyleProvider    *provider,
 
   tree_rules = _gtk_css_selector_tree_match_all (priv->tree, matcher);
   if (tree_rules)
-    {
-      verify_tree_match_results (css_provider, matcher, tree_rules);
+    verify_tree_match_results (css_provider, matcher, tree_rules);
 
+  if (priv->rules->len > 0)
+    tree_rules = gtk_css_provider_match_added_rules (css_provider, matcher, tree_rules);
+
+  if (tree_rules)
+    {
       for (i = tree_rules->len - 1; i >= 0; i--)
         {
           ruleset = tree_rules->pdata[i];
@@ -611,6 +705,13 @@ gtk_css_style_provider_lookup (GtkStyleProvider    *provider,
 
       *change = _gtk_css_selector_tree_get_change_all (priv->tree, &change_matcher);
       verify_tree_get_change_results (css_provider, &change_matcher, *change);
+
+      for (i = 0; i < priv->rules->len; i++)
+        {
+          GtkCssRules *rules = g_ptr_array_index (priv->rules, i);
+
+          *change |= _gtk_css_selector_tree_get_change_all (rules->tree, &change_matcher);
+        }
     }
 }
 
@@ -635,6 +736,7 @@ gtk_css_provider_finalize (GObject *object)
 
   g_array_free (priv->rulesets, TRUE);
   _gtk_css_selector_tree_free (priv->tree);
+  g_ptr_array_unref (priv->rules);
 
   g_hash_table_destroy (priv->symbolic_colors);
   g_hash_table_destroy (priv->keyframes);
@@ -726,11 +828,10 @@ gtk_css_provider_invalid_token (GtkCssProvider *provider,
 }
 
 static void
-css_provider_commit (GtkCssProvider *css_provider,
+css_provider_commit (GtkCssScanner  *scanner,
                      GSList         *selectors,
                      GtkCssRuleset  *ruleset)
 {
-  GtkCssProviderPrivate *priv = gtk_css_provider_get_instance_private (css_provider);
   GSList *l;
 
   for (l = selectors; l; l = l->next)
@@ -739,7 +840,7 @@ css_provider_commit (GtkCssProvider *css_provider,
 
       gtk_css_ruleset_init_copy (&new, ruleset, l->data);
 
-      g_array_append_val (priv->rulesets, new);
+      g_array_append_val (scanner->rulesets, new);
     }
 
   g_slist_free (selectors);
@@ -772,6 +873,7 @@ gtk_css_provider_reset (GtkCssProvider *css_provider)
   g_array_set_size (priv->rulesets, 0);
   _gtk_css_selector_tree_free (priv->tree);
   priv->tree = NULL;
+  g_ptr_array_set_size (priv->rules, 0);
 
 }
 
@@ -1286,7 +1388,7 @@ parse_ruleset (GtkCssScanner *scanner)
         }
     }
 
-  css_provider_commit (scanner->provider, selectors, &ruleset);
+  css_provider_commit (scanner, selectors, &ruleset);
   gtk_css_ruleset_clear (&ruleset);
   gtk_css_scanner_pop_section (scanner, GTK_CSS_SECTION_RULESET);
 }
@@ -1334,21 +1436,34 @@ gtk_css_provider_compare_rule (gconstpointer a_,
   return 0;
 }
 
-static void
-gtk_css_provider_postprocess (GtkCssProvider *css_provider)
+static guint
+gtk_css_ruleset_compute_specificity (const GtkCssRuleset *ruleset)
+{
+  guint ids = 0, classes = 0, elements = 0;
+
+  _gtk_css_selector_get_specificity (ruleset->selector, &ids, &classes, &elements);
+
+  return (MIN (ids, 0x3FF) << 20) | (MIN (classes, 0x3FF) << 10) | MIN (elements, 0x3FF);
+}
+
+static GtkCssSelectorTree *
+gtk_css_rulesets_build_tree (GArray *rulesets,
+                             guint   origin)
 {
-  GtkCssProviderPrivate *priv = gtk_css_provider_get_instance_private (css_provider);
   GtkCssSelectorTreeBuilder *builder;
+  GtkCssSelectorTree *tree;
   guint i;
 
-  g_array_sort (priv->rulesets, gtk_css_provider_compare_rule);
+  g_array_sort (rulesets, gtk_css_provider_compare_rule);
 
   builder = _gtk_css_selector_tree_builder_new ();
-  for (i = 0; i < priv->rulesets->len; i++)
+  for (i = 0; i < rulesets->len; i++)
     {
       GtkCssRuleset *ruleset;
 
-      ruleset = &g_array_index (priv->rulesets, GtkCssRuleset, i);
+      ruleset = &g_array_index (rulesets, GtkCssRuleset, i);
+      ruleset->specificity = gtk_css_ruleset_compute_specificity (ruleset);
+      ruleset->origin = origin;
 
       _gtk_css_selector_tree_builder_add (builder,
 					  ruleset->selector,
@@ -1356,20 +1471,30 @@ gtk_css_provider_postprocess (GtkCssProvider *css_provider)
 					  ruleset);
     }
 
-  priv->tree = _gtk_css_selector_tree_builder_build (builder);
+  tree = _gtk_css_selector_tree_builder_build (builder);
   _gtk_css_selector_tree_builder_free (builder);
 
 #ifndef VERIFY_TREE
-  for (i = 0; i < priv->rulesets->len; i++)
+  for (i = 0; i < rulesets->len; i++)
     {
       GtkCssRuleset *ruleset;
 
-      ruleset = &g_array_index (priv->rulesets, GtkCssRuleset, i);
+      ruleset = &g_array_index (rulesets, GtkCssRuleset, i);
 
       _gtk_css_selector_free (ruleset->selector);
       ruleset->selector = NULL;
     }
 #endif
+
+  return tree;
+}
+
+static void
+gtk_css_provider_postprocess (GtkCssProvider *css_provider)
+{
+  GtkCssProviderPrivate *priv = gtk_css_provider_get_instance_private (css_provider);
+
+  priv->tree = gtk_css_rulesets_build_tree (priv->rulesets, 0);
 }
 
 static void
@@ -1567,6 +1692,127 @@ gtk_css_provider_load_from_resource (GtkCssProvider *css_provider,
   g_object_unref (file);
 }
 
+static gboolean
+gtk_css_rules_may_affect (const GtkCssMatcher *matcher,
+                          gpointer             data)
+{
+  GtkCssRules *rules = data;
+  GtkCssMatcher superset;
+
+  /* Also catch nodes that don't match now but might after a
+   * state change, their change flags need to be updated, too. */
+  _gtk_css_matcher_superset_init (&superset, matcher, GTK_CSS_CHANGE_NAME | GTK_CSS_CHANGE_CLASS);
+
+  return _gtk_css_selector_tree_may_match (rules->tree, &superset);
+}
+
+/**
+ * gtk_css_provider_add_rules:
+ * @css_provider: a #GtkCssProvider
+ * @data: (array length=length) (element-type guint8): CSS data loaded in memory
+ * @length: the length of @data in bytes, or -1 for NUL terminated strings
+ *
+ * Parses @data and adds the contained rules to @css_provider without
+ * clearing the previously loaded information.
+ *
+ * The added rules take precedence over previously loaded rules of
+ * the same specificity. Only the style of nodes that can be matched
+ * by the new rules will be updated, so this is a lot cheaper than
+ * reloading the whole provider for small runtime changes, like
+ * changing an accent color.
+ *
+ * Color definitions and keyframes contained in @data are added to
+ * the provider, too, but they are not removed by
+ * gtk_css_provider_remove_rules().
+ *
+ * Returns: an identifier to pass to gtk_css_provider_remove_rules()
+ **/
+guint
+gtk_css_provider_add_rules (GtkCssProvider *css_provider,
+                            const gchar    *data,
+                            gssize          length)
+{
+  GtkCssProviderPrivate *priv;
+  GtkCssScanner *scanner;
+  GtkCssRules *rules;
+  char *free_data;
+
+  g_return_val_if_fail (GTK_IS_CSS_PROVIDER (css_provider), 0);
+  g_return_val_if_fail (data != NULL, 0);
+
+  priv = gtk_css_provider_get_instance_private (css_provider);
+
+  if (length < 0)
+    {
+      free_data = NULL;
+    }
+  else
+    {
+      free_data = g_strndup (data, length);
+      data = free_data;
+    }
+
+  rules = g_slice_new0 (GtkCssRules);
+  rules->id = ++priv->last_rules_id;
+  rules->rulesets = g_array_new (FALSE, FALSE, sizeof (GtkCssRuleset));
+
+  scanner = gtk_css_scanner_new (css_provider, NULL, NULL, NULL, data);
+  scanner->rulesets = rules->rulesets;
+  parse_stylesheet (scanner);
+  gtk_css_scanner_destroy (scanner);
+
+  rules->tree = gtk_css_rulesets_build_tree (rules->rulesets, rules->id);
+  g_ptr_array_add (priv->rules, rules);
+
+  g_free (free_data);
+
+  gtk_style_provider_changed_filtered (GTK_STYLE_PROVIDER (css_provider),
+                                       gtk_css_rules_may_affect,
+                                       rules);
+
+  return rules->id;
+}
+
+/**
+ * gtk_css_provider_remove_rules:
+ * @css_provider: a #GtkCssProvider
+ * @id: an identifier returned by gtk_css_provider_add_rules()
+ *
+ * Removes the rules that were added with gtk_css_provider_add_rules().
+ *
+ * Rules that were added before @css_provider was reloaded have
+ * already been removed, calling this function for them does nothing.
+ **/
+void
+gtk_css_provider_remove_rules (GtkCssProvider *css_provider,
+                               guint           id)
+{
+  GtkCssProviderPrivate *priv;
+  guint i;
+
+  g_return_if_fail (GTK_IS_CSS_PROVIDER (css_provider));
+  g_return_if_fail (id > 0);
+
+  priv = gtk_css_provider_get_instance_private (css_provider);
+
+  for (i = 0; i < priv->rules->len; i++)
+    {
+      GtkCssRules *rules = g_ptr_array_index (priv->rules, i);
+
+      if (rules->id != id)
+        continue;
+
+      /* Nodes only get invalidated here and restyled later,
+       * so it's fine to keep the rules around until we're done. */
+      gtk_style_provider_changed_filtered (GTK_STYLE_PROVIDER (css_provider),
+                                           gtk_css_rules_may_affect,
+                                           rules);
+
+      g_ptr_array_remove_index (priv->rules, i);
+      return;
+    }
+}
+
 gchar *
 _gtk_get_theme_dir (void)
 {
@@ -1942,6 +2188,19 @@ gtk_css_provider_to_string (GtkCssProvider *provider)
       gtk_css_ruleset_print (&g_array_index (priv->rulesets, GtkCssRuleset, i), str);
     }
 
+  for (i = 0; i < priv->rules->len; i++)
+    {
+      GtkCssRules *rules = g_ptr_array_index (priv->rules, i);
+      guint j;
+
+      for (j = 0; j < rules->rulesets->len; j++)
+        {
+          if (str->len != 0)
+            g_string_append (str, "\n");
+          gtk_css_ruleset_print (&g_array_index (rules->rulesets, GtkCssRuleset, j), str);
+        }
+    }
+
   return g_string_free (str, FALSE);
 }
 
@@ -108,6 +108,14 @@ GDK_AVAILABLE_IN_ALL
 void             gtk_css_provider_load_from_resource (GtkCssProvider *css_provider,
                                                       const gchar    *resource_path);
 
+GDK_AVAILABLE_IN_ALL
+guint            gtk_css_provider_add_rules      (GtkCssProvider  *css_provider,
+                                                  const gchar     *data,
+                                                  gssize           length);
+GDK_AVAILABLE_IN_ALL
+void             gtk_css_provider_remove_rules   (GtkCssProvider  *css_provider,
+                                                  guint            id);
+
 GDK_AVAILABLE_IN_ALL
 GtkCssProvider * gtk_css_provider_get_named (const gchar *name,
                                              const gchar *variant);
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "gtkcssprofilerprivate.h"
 #include "gtkcssprovider.h"
 #include "gtkstylecontextprivate.h"
 
@@ -926,9 +927,9 @@ parse_selector_class (GtkCssParser   *parser,
                       GtkCssSelector *selector,
                       gboolean        negate)
 {
-  char *name;
+  const char *name;
     
-  name = _gtk_css_parser_try_name (parser, FALSE);
+  name = _gtk_css_parser_try_name_intern (parser, FALSE);
 
   if (name == NULL)
     {
@@ -941,9 +942,7 @@ parse_selector_class (GtkCssParser   *parser,
   selector = gtk_css_selector_new (negate ? &GTK_CSS_SELECTOR_NOT_CLASS
                                           : &GTK_CSS_SELECTOR_CLASS,
                                    selector);
-  selector->style_class.style_class = g_quark_from_string (name);
-
-  g_free (name);
+  selector->style_class.style_class = g_quark_from_static_string (name);
 
   return selector;
 }
@@ -953,9 +952,9 @@ parse_selector_id (GtkCssParser   *parser,
                    GtkCssSelector *selector,
                    gboolean        negate)
 {
-  char *name;
+  const char *name;
     
-  name = _gtk_css_parser_try_name (parser, FALSE);
+  name = _gtk_css_parser_try_name_intern (parser, FALSE);
 
   if (name == NULL)
     {
@@ -968,9 +967,7 @@ parse_selector_id (GtkCssParser   *parser,
   selector = gtk_css_selector_new (negate ? &GTK_CSS_SELECTOR_NOT_ID
                                           : &GTK_CSS_SELECTOR_ID,
                                    selector);
-  selector->id.name = g_intern_string (name);
-
-  g_free (name);
+  selector->id.name = name;
 
   return selector;
 }
@@ -1169,15 +1166,14 @@ static GtkCssSelector *
 parse_selector_negation (GtkCssParser   *parser,
                          GtkCssSelector *selector)
 {
-  char *name;
+  const char *name;
 
-  name = _gtk_css_parser_try_ident (parser, FALSE);
+  name = _gtk_css_parser_try_ident_intern (parser, FALSE);
   if (name)
     {
       selector = gtk_css_selector_new (&GTK_CSS_SELECTOR_NOT_NAME,
                                        selector);
-      selector->name.name = g_intern_string (name);
-      g_free (name);
+      selector->name.name = name;
     }
   else if (_gtk_css_parser_try (parser, "*", FALSE))
     selector = gtk_css_selector_new (&GTK_CSS_SELECTOR_NOT_ANY, selector);
@@ -1213,14 +1209,13 @@ parse_simple_selector (GtkCssParser   *parser,
                        GtkCssSelector *selector)
 {
   gboolean parsed_something = FALSE;
-  char *name;
+  const char *name;
 
-  name = _gtk_css_parser_try_ident (parser, FALSE);
+  name = _gtk_css_parser_try_ident_intern (parser, FALSE);
   if (name)
     {
       selector = gtk_css_selector_new (&GTK_CSS_SELECTOR_NAME, selector);
-      selector->name.name = g_intern_string (name);
-      g_free (name);
+      selector->name.name = name;
       parsed_something = TRUE;
     }
   else if (_gtk_css_parser_try (parser, "*", FALSE))
@@ -1363,7 +1358,7 @@ _gtk_css_selector_matches (const GtkCssSelector *selector,
 
 /* Computes specificity according to CSS 2.1.
  * The arguments must be initialized to 0 */
-static void
+void
 _gtk_css_selector_get_specificity (const GtkCssSelector *selector,
                                    guint                *ids,
                                    guint                *classes,
@@ -1476,6 +1471,27 @@ gtk_css_selectors_skip_initial_selector (GtkCssSelector *selector, const GtkCssS
   return (GtkCssSelector *)gtk_css_selector_previous (selector);
 }
 
+static void
+gtk_css_selector_tree_print_for_profiler (gconstpointer  tree,
+                                          GString       *str)
+{
+  _gtk_css_selector_tree_match_print (tree, str);
+}
+
+static inline gboolean
+gtk_css_selector_tree_match_one (const GtkCssSelectorTree *tree,
+                                 const GtkCssMatcher      *matcher)
+{
+  gboolean result;
+
+  result = gtk_css_selector_match (&tree->selector, matcher);
+
+  if (G_UNLIKELY (gtk_css_profiler_get_enabled ()))
+    gtk_css_profiler_count_selector (tree, gtk_css_selector_tree_print_for_profiler, result);
+
+  return result;
+}
+
 static gboolean
 gtk_css_selector_tree_match_foreach (const GtkCssSelector *selector,
                                      const GtkCssMatcher  *matcher,
@@ -1484,7 +1500,7 @@ gtk_css_selector_tree_match_foreach (const GtkCssSelector *selector,
   const GtkCssSelectorTree *tree = (const GtkCssSelectorTree *) selector;
   const GtkCssSelectorTree *prev;
 
-  if (!gtk_css_selector_match (selector, matcher))
+  if (!gtk_css_selector_tree_match_one (tree, matcher))
     return FALSE;
 
   gtk_css_selector_tree_found_match (tree, res);
@@ -1544,6 +1560,7 @@ gtk_css_selector_tree_get_change (const GtkCssSelectorTree *tree,
   GtkCssChange change = 0;
   const GtkCssSelectorTree *prev;
 
+  /* Superset matches are not real matches, don't count them */
   if (!gtk_css_selector_match (&tree->selector, matcher))
     return 0;
 
@@ -1578,6 +1595,24 @@ _gtk_css_selector_tree_get_change_all (const GtkCssSelectorTree *tree,
   return change & ~GTK_CSS_CHANGE_RESERVED_BIT;
 }
 
+/* Returns %TRUE if any selector in @tree matches @matcher. Use a
+ * superset matcher to find out if a node could be affected by the
+ * rules in @tree at all. */
+gboolean
+_gtk_css_selector_tree_may_match (const GtkCssSelectorTree *tree,
+                                  const GtkCssMatcher      *matcher)
+{
+  for (; tree != NULL;
+       tree = gtk_css_selector_tree_get_sibling (tree))
+    {
+      /* relies on GTK_CSS_CHANGE_GOT_MATCH being set on matches */
+      if (gtk_css_selector_tree_get_change (tree, matcher) != 0)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
 #ifdef PRINT_TREE
 static void
 _gtk_css_selector_tree_print (const GtkCssSelectorTree *tree, GString *str, char *prefix)
@@ -1676,6 +1711,8 @@ _gtk_css_selector_tree_free (GtkCssSelectorTree *tree)
   if (tree == NULL)
     return;
 
+  gtk_css_profiler_forget_selectors ();
+
   g_free (tree);
 }
 
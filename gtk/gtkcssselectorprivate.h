@@ -39,12 +39,18 @@ gboolean          _gtk_css_selector_matches         (const GtkCssSelector   *sel
 GtkCssChange      _gtk_css_selector_get_change      (const GtkCssSelector   *selector);
 int               _gtk_css_selector_compare         (const GtkCssSelector   *a,
                                                      const GtkCssSelector   *b);
+void              _gtk_css_selector_get_specificity (const GtkCssSelector   *selector,
+                                                     guint                  *ids,
+                                                     guint                  *classes,
+                                                     guint                  *elements);
 
 void         _gtk_css_selector_tree_free             (GtkCssSelectorTree       *tree);
 GPtrArray *  _gtk_css_selector_tree_match_all        (const GtkCssSelectorTree *tree,
 						      const GtkCssMatcher      *matcher);
 GtkCssChange _gtk_css_selector_tree_get_change_all   (const GtkCssSelectorTree *tree,
 						      const GtkCssMatcher *matcher);
+gboolean     _gtk_css_selector_tree_may_match        (const GtkCssSelectorTree *tree,
+						      const GtkCssMatcher      *matcher);
 void         _gtk_css_selector_tree_match_print      (const GtkCssSelectorTree *tree,
 						      GString                  *str);
 
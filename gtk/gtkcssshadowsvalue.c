@@ -113,6 +113,18 @@ gtk_css_value_shadows_equal (const GtkCssValue *value1,
   return TRUE;
 }
 
+static guint
+gtk_css_value_shadows_hash (const GtkCssValue *value)
+{
+  guint i, hash;
+
+  hash = value->len;
+  for (i = 0; i < value->len; i++)
+    hash = hash * 31 + gtk_css_value_hash (value->values[i]);
+
+  return hash;
+}
+
 static GtkCssValue *
 gtk_css_value_shadows_transition (GtkCssValue *start,
                                   GtkCssValue *end,
@@ -206,7 +218,8 @@ static const GtkCssValueClass GTK_CSS_VALUE_SHADOWS = {
   gtk_css_value_shadows_transition,
   NULL,
   NULL,
-  gtk_css_value_shadows_print
+  gtk_css_value_shadows_print,
+  gtk_css_value_shadows_hash
 };
 
 static GtkCssValue none_singleton = { &GTK_CSS_VALUE_SHADOWS, 1, 0, { NULL } };
@@ -19,8 +19,39 @@
 
 #include "gtkcssstylechangeprivate.h"
 
+#include "gtkcssanimatedstyleprivate.h"
 #include "gtkcssstylepropertyprivate.h"
 
+static GtkCssStyle *
+gtk_css_style_get_static_style (GtkCssStyle *style)
+{
+  if (GTK_IS_CSS_ANIMATED_STYLE (style))
+    return GTK_CSS_ANIMATED_STYLE (style)->style;
+
+  return style;
+}
+
+/* When both styles are built on the same static style, only the
+ * properties overridden by animations can differ. This is the
+ * common case on every animation tick. */
+static GtkBitmask *
+gtk_css_style_change_get_candidates (GtkCssStyle *old_style,
+                                     GtkCssStyle *new_style)
+{
+  GtkBitmask *candidates;
+
+  if (gtk_css_style_get_static_style (old_style) != gtk_css_style_get_static_style (new_style))
+    return NULL;
+
+  candidates = _gtk_bitmask_new ();
+  if (GTK_IS_CSS_ANIMATED_STYLE (old_style))
+    candidates = _gtk_bitmask_union (candidates, GTK_CSS_ANIMATED_STYLE (old_style)->animated_properties);
+  if (GTK_IS_CSS_ANIMATED_STYLE (new_style))
+    candidates = _gtk_bitmask_union (candidates, GTK_CSS_ANIMATED_STYLE (new_style)->animated_properties);
+
+  return candidates;
+}
+
 void
 gtk_css_style_change_init (GtkCssStyleChange *change,
                            GtkCssStyle       *old_style,
@@ -33,10 +64,13 @@ gtk_css_style_change_init (GtkCssStyleChange *change,
 
   change->affects = 0;
   change->changes = _gtk_bitmask_new ();
+  change->candidates = NULL;
   
   /* Make sure we don't do extra work if old and new are equal. */
   if (old_style == new_style)
     change->n_compared = GTK_CSS_PROPERTY_N_PROPERTIES;
+  else
+    change->candidates = gtk_css_style_change_get_candidates (old_style, new_style);
 }
 
 void
@@ -45,6 +79,8 @@ gtk_css_style_change_finish (GtkCssStyleChange *change)
   g_object_unref (change->old_style);
   g_object_unref (change->new_style);
   _gtk_bitmask_free (change->changes);
+  if (change->candidates)
+    _gtk_bitmask_free (change->candidates);
 }
 
 GtkCssStyle *
@@ -62,11 +98,25 @@ gtk_css_style_change_get_new_style (GtkCssStyleChange *change)
 static gboolean
 gtk_css_style_compare_next_value (GtkCssStyleChange *change)
 {
+  GtkCssValue *old_value, *new_value;
+
   if (change->n_compared == GTK_CSS_PROPERTY_N_PROPERTIES)
     return FALSE;
 
-  if (!_gtk_css_value_equal (gtk_css_style_get_value (change->old_style, change->n_compared),
-                             gtk_css_style_get_value (change->new_style, change->n_compared)))
+  if (change->candidates &&
+      !_gtk_bitmask_get (change->candidates, change->n_compared))
+    {
+      change->n_compared++;
+      return TRUE;
+    }
+
+  old_value = gtk_css_style_get_value (change->old_style, change->n_compared);
+  new_value = gtk_css_style_get_value (change->new_style, change->n_compared);
+
+  /* Computed values are interned, so unchanged properties
+   * almost always share the same instance. */
+  if (old_value != new_value &&
+      !_gtk_css_value_equal (old_value, new_value))
     {
       change->affects |= _gtk_css_style_property_get_affects (_gtk_css_style_property_lookup_by_id (change->n_compared));
       change->changes = _gtk_bitmask_set (change->changes, change->n_compared, TRUE);
@@ -29,6 +29,7 @@ struct _GtkCssStyleChange {
   GtkCssStyle   *new_style;
 
   guint          n_compared;
+  GtkBitmask    *candidates;    /* NULL or the only properties that may differ */
 
   GtkCssAffects  affects;
   GtkBitmask    *changes;
@@ -29,6 +29,24 @@ struct _GtkCssValue {
 
 G_DEFINE_BOXED_TYPE (GtkCssValue, _gtk_css_value, _gtk_css_value_ref, _gtk_css_value_unref)
 
+/* Weak set of computed values, see gtk_css_value_intern().
+ * Entries do not hold a reference, values remove themselves
+ * when their last reference goes away. */
+static GHashTable *intern_table = NULL;
+
+static guint
+gtk_css_value_intern_hash (gconstpointer value)
+{
+  return gtk_css_value_hash (value);
+}
+
+static gboolean
+gtk_css_value_intern_equal (gconstpointer value1,
+                            gconstpointer value2)
+{
+  return _gtk_css_value_equal (value1, value2);
+}
+
 GtkCssValue *
 _gtk_css_value_alloc (const GtkCssValueClass *klass,
                       gsize                   size)
@@ -63,6 +81,11 @@ gtk_css_value_unref (GtkCssValue *value)
   if (value->ref_count > 0)
     return;
 
+  if (value->class->hash != NULL &&
+      intern_table != NULL &&
+      g_hash_table_lookup (intern_table, value) == value)
+    g_hash_table_remove (intern_table, value);
+
   value->class->free (value);
 }
 
@@ -88,7 +111,7 @@ _gtk_css_value_compute (GtkCssValue      *value,
                         GtkCssStyle      *style,
                         GtkCssStyle      *parent_style)
 {
-  return value->class->compute (value, property_id, provider, style, parent_style);
+  return gtk_css_value_intern (value->class->compute (value, property_id, provider, style, parent_style));
 }
 
 gboolean
@@ -121,6 +144,70 @@ _gtk_css_value_equal0 (const GtkCssValue *value1,
   return _gtk_css_value_equal (value1, value2);
 }
 
+/**
+ * gtk_css_value_hash:
+ * @value: a #GtkCssValue
+ *
+ * Computes a hash for @value that is consistent with
+ * _gtk_css_value_equal(). Values of classes that don't implement
+ * a hash function all hash to their class.
+ *
+ * Returns: the hash value
+ **/
+guint
+gtk_css_value_hash (const GtkCssValue *value)
+{
+  gtk_internal_return_val_if_fail (value != NULL, 0);
+
+  if (value->class->hash == NULL)
+    return GPOINTER_TO_UINT (value->class);
+
+  return value->class->hash (value);
+}
+
+/**
+ * gtk_css_value_intern:
+ * @value: (transfer full): the value to intern
+ *
+ * Looks up a value equal to @value in the global table of interned
+ * values. If one exists, @value is released and the existing one is
+ * returned instead, otherwise @value becomes the interned instance.
+ *
+ * This way, identical computed values such as "0px" or "transparent"
+ * share a single instance and can be compared by pointer.
+ *
+ * Only values whose class implements the hash vfunc are interned,
+ * all other values are returned unchanged.
+ *
+ * Returns: (transfer full): the interned value
+ **/
+GtkCssValue *
+gtk_css_value_intern (GtkCssValue *value)
+{
+  GtkCssValue *interned;
+
+  if (value == NULL || value->class->hash == NULL)
+    return value;
+
+  if (G_UNLIKELY (intern_table == NULL))
+    intern_table = g_hash_table_new (gtk_css_value_intern_hash, gtk_css_value_intern_equal);
+
+  interned = g_hash_table_lookup (intern_table, value);
+  if (interned == value)
+    return value;
+
+  if (interned != NULL)
+    {
+      _gtk_css_value_ref (interned);
+      _gtk_css_value_unref (value);
+      return interned;
+    }
+
+  g_hash_table_add (intern_table, value);
+
+  return value;
+}
+
 GtkCssValue *
 _gtk_css_value_transition (GtkCssValue *start,
                            GtkCssValue *end,
@@ -554,6 +554,7 @@ static void         gtk_entry_draw_cursor              (GtkEntry       *entry,
 static PangoLayout *gtk_entry_ensure_layout            (GtkEntry       *entry,
                                                         gboolean        include_preedit);
 static void         gtk_entry_reset_layout             (GtkEntry       *entry);
+static void         gtk_entry_recompute_cursor         (GtkEntry       *entry);
 static void         gtk_entry_recompute                (GtkEntry       *entry);
 static gint         gtk_entry_find_position            (GtkEntry       *entry,
 							gint            x);
@@ -1936,6 +1937,7 @@ gtk_entry_set_property (GObject         *object,
 
 		priv->preedit_length = 0;
 		priv->preedit_cursor = 0;
+		gtk_entry_reset_layout (entry);
 
                 gtk_style_context_remove_class (context, GTK_STYLE_CLASS_READ_ONLY);
 	      }
@@ -4550,8 +4552,9 @@ buffer_inserted_text (GtkEntryBuffer *buffer,
   if (selection_bound > position)
     selection_bound += n_chars;
 
+  gtk_entry_reset_layout (entry);
   gtk_entry_set_positions (entry, current_pos, selection_bound);
-  gtk_entry_recompute (entry);
+  gtk_entry_recompute_cursor (entry);
 
   /* Calculate the password hint if it needs to be displayed. */
   if (n_chars == 1 && !priv->visible)
@@ -4601,8 +4604,9 @@ buffer_deleted_text (GtkEntryBuffer *buffer,
   if (selection_bound > position)
     selection_bound -= MIN (selection_bound, end_pos) - position;
 
+  gtk_entry_reset_layout (entry);
   gtk_entry_set_positions (entry, current_pos, selection_bound);
-  gtk_entry_recompute (entry);
+  gtk_entry_recompute_cursor (entry);
 
   /* We might have deleted the selection */
   gtk_entry_update_primary_selection (entry);
@@ -5354,9 +5358,15 @@ gtk_entry_set_positions (GtkEntry *entry,
         }
     }
 
+  /* The layout only depends on the cursor while there is preedit
+   * text, so don't reshape the whole text for cursor movement.
+   */
   if (changed)
     {
-      gtk_entry_recompute (entry);
+      if (priv->preedit_length > 0)
+        gtk_entry_recompute (entry);
+      else
+        gtk_entry_recompute_cursor (entry);
     }
 }
 
@@ -5403,11 +5413,18 @@ update_im_cursor_location (GtkEntry *entry)
 
 static void
 gtk_entry_recompute (GtkEntry *entry)
+{
+  gtk_entry_reset_layout (entry);
+  gtk_entry_recompute_cursor (entry);
+}
+
+/* Like gtk_entry_recompute(), but keeps the cached layout */
+static void
+gtk_entry_recompute_cursor (GtkEntry *entry)
 {
   GtkEntryPrivate *priv = gtk_entry_get_instance_private (entry);
   GtkTextHandleMode handle_mode;
 
-  gtk_entry_reset_layout (entry);
   gtk_entry_check_cursor_blink (entry);
 
   gtk_entry_adjust_scroll (entry);
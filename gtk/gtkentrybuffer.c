@@ -121,6 +121,20 @@ gtk_entry_buffer_normal_get_length (GtkEntryBuffer *buffer)
   return priv->normal_text_chars;
 }
 
+/* Converts a character offset into a byte offset. Text that is all
+ * ASCII is common and lets us skip walking the string, which matters
+ * when editing near the end of a very long value.
+ */
+static gsize
+gtk_entry_buffer_normal_offset_to_index (GtkEntryBufferPrivate *pv,
+                                         guint                  offset)
+{
+  if (pv->normal_text_bytes == pv->normal_text_chars)
+    return offset;
+
+  return g_utf8_offset_to_pointer (pv->normal_text, offset) - pv->normal_text;
+}
+
 static guint
 gtk_entry_buffer_normal_insert_text (GtkEntryBuffer *buffer,
                                      guint           position,
@@ -173,7 +187,7 @@ gtk_entry_buffer_normal_insert_text (GtkEntryBuffer *buffer,
     }
 
   /* Actual text insertion */
-  at = g_utf8_offset_to_pointer (pv->normal_text, position) - pv->normal_text;
+  at = gtk_entry_buffer_normal_offset_to_index (pv, position);
   memmove (pv->normal_text + at + n_bytes, pv->normal_text + at, pv->normal_text_bytes - at);
   memcpy (pv->normal_text + at, chars, n_bytes);
 
@@ -201,8 +215,11 @@ gtk_entry_buffer_normal_delete_text (GtkEntryBuffer *buffer,
 
   if (n_chars > 0)
     {
-      start = g_utf8_offset_to_pointer (pv->normal_text, position) - pv->normal_text;
-      end = g_utf8_offset_to_pointer (pv->normal_text, position + n_chars) - pv->normal_text;
+      start = gtk_entry_buffer_normal_offset_to_index (pv, position);
+      if (pv->normal_text_bytes == pv->normal_text_chars)
+        end = start + n_chars;
+      else
+        end = g_utf8_offset_to_pointer (pv->normal_text + start, n_chars) - pv->normal_text;
 
       memmove (pv->normal_text + start, pv->normal_text + end, pv->normal_text_bytes + 1 - end);
       pv->normal_text_chars -= n_chars;
@@ -21,7 +21,7 @@
 
 #include "gtkfilterlistmodel.h"
 
-#include "gtkrbtreeprivate.h"
+#include "gtkbtreeprivate.h"
 #include "gtkintl.h"
 #include "gtkprivate.h"
 
@@ -35,22 +35,41 @@
  * listmodel.
  * It hides some elements from the other model according to
  * criteria given by a #GtkFilterListModelFilterFunc.
+ *
+ * By default, filtering happens synchronously whenever the filter
+ * changes. For large models, #GtkFilterListModel:incremental can be
+ * set to filter in small batches from an idle handler, so that the
+ * application stays responsive. While this is going on, items that
+ * have not been looked at yet keep their previous visibility and
+ * #GtkFilterListModel:pending tells how many of them are left.
  */
 
 enum {
   PROP_0,
   PROP_HAS_FILTER,
+  PROP_INCREMENTAL,
   PROP_ITEM_TYPE,
   PROP_MODEL,
+  PROP_PENDING,
   NUM_PROPERTIES
 };
 
 typedef struct _FilterNode FilterNode;
 typedef struct _FilterAugment FilterAugment;
 
+/* Visibility is stored as bitsets in chunks of up to this many items,
+ * so that even huge models only need a few nodes. */
+#define FILTER_CHUNK_SIZE 512
+#define FILTER_CHUNK_WORDS (FILTER_CHUNK_SIZE / 32)
+
+/* Time in microseconds that incremental filtering may take per idle */
+#define FILTER_INCREMENTAL_TIME_SLICE 1000
+
 struct _FilterNode
 {
-  guint visible : 1;
+  guint n_items;
+  guint n_visible;
+  guint32 visible[FILTER_CHUNK_WORDS];
 };
 
 struct _FilterAugment
@@ -69,7 +88,12 @@ struct _GtkFilterListModel
   gpointer user_data;
   GDestroyNotify user_destroy;
 
-  GtkRbTree *items; /* NULL if filter_func == NULL */
+  GtkBTree *items; /* NULL if filter_func == NULL */
+
+  gboolean incremental;
+  guint pending_start; /* items in [pending_start, pending_end) still need filtering */
+  guint pending_end;
+  guint pending_source_id;
 };
 
 struct _GtkFilterListModelClass
@@ -79,90 +103,219 @@ struct _GtkFilterListModelClass
 
 static GParamSpec *properties[NUM_PROPERTIES] = { NULL, };
 
-static FilterNode *
-gtk_filter_list_model_get_nth_filtered (GtkRbTree *tree,
-                                        guint      position,
-                                        guint     *out_unfiltered)
+static inline guint
+popcount32 (guint32 v)
 {
-  FilterNode *node, *tmp;
-  guint unfiltered;
+  v = v - ((v >> 1) & 0x55555555);
+  v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+  return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
 
-  node = gtk_rb_tree_get_root (tree);
-  unfiltered = 0;
+static inline gboolean
+filter_node_get (FilterNode *node,
+                 guint       i)
+{
+  return (node->visible[i / 32] >> (i % 32)) & 1;
+}
 
-  while (node)
+static inline void
+filter_node_set (FilterNode *node,
+                 guint       i,
+                 gboolean    visible)
+{
+  guint32 mask = 1u << (i % 32);
+
+  if (visible == ((node->visible[i / 32] & mask) != 0))
+    return;
+
+  if (visible)
     {
-      tmp = gtk_rb_tree_node_get_left (node);
-      if (tmp)
-        {
-          FilterAugment *aug = gtk_rb_tree_get_augment (tree, tmp);
-          if (position < aug->n_visible)
-            {
-              node = tmp;
-              continue;
-            }
-          position -= aug->n_visible;
-          unfiltered += aug->n_items;
-        }
+      node->visible[i / 32] |= mask;
+      node->n_visible++;
+    }
+  else
+    {
+      node->visible[i / 32] &= ~mask;
+      node->n_visible--;
+    }
+}
 
-      if (node->visible)
-        {
-          if (position == 0)
-            break;
-          position--;
-        }
+/* number of visible items before @n */
+static guint
+filter_node_rank (FilterNode *node,
+                  guint       n)
+{
+  guint i, result;
 
-      unfiltered++;
+  result = 0;
+  for (i = 0; i < n / 32; i++)
+    result += popcount32 (node->visible[i]);
+  if (n % 32)
+    result += popcount32 (node->visible[i] & ((1u << (n % 32)) - 1));
 
-      node = gtk_rb_tree_node_get_right (node);
+  return result;
+}
+
+/* position of the visible item number @n */
+static guint
+filter_node_select (FilterNode *node,
+                    guint       n)
+{
+  guint i, count;
+  guint32 word;
+
+  for (i = 0; ; i++)
+    {
+      count = popcount32 (node->visible[i]);
+      if (n < count)
+        break;
+      n -= count;
     }
 
-  if (out_unfiltered)
-    *out_unfiltered = unfiltered;
+  word = node->visible[i];
+  for (; n > 0; n--)
+    word &= word - 1;
 
-  return node;
+  return i * 32 + popcount32 ((word & -word) - 1);
 }
 
-static FilterNode *
-gtk_filter_list_model_get_nth (GtkRbTree *tree,
-                               guint      position,
-                               guint     *out_filtered)
+/* make room for @n invisible items at @offset */
+static void
+filter_node_insert (FilterNode *node,
+                    guint       offset,
+                    guint       n)
 {
-  FilterNode *node, *tmp;
-  guint filtered;
+  guint i;
 
-  node = gtk_rb_tree_get_root (tree);
-  filtered = 0;
+  g_assert (node->n_items + n <= FILTER_CHUNK_SIZE);
 
-  while (node)
+  if (n == 0)
+    return;
+
+  for (i = node->n_items; i-- > offset;)
     {
-      tmp = gtk_rb_tree_node_get_left (node);
-      if (tmp)
+      if (filter_node_get (node, i))
         {
-          FilterAugment *aug = gtk_rb_tree_get_augment (tree, tmp);
-          if (position < aug->n_items)
-            {
-              node = tmp;
-              continue;
-            }
-          position -= aug->n_items;
-          filtered += aug->n_visible;
+          node->visible[(i + n) / 32] |= 1u << ((i + n) % 32);
+          node->visible[i / 32] &= ~(1u << (i % 32));
         }
+      else
+        node->visible[(i + n) / 32] &= ~(1u << ((i + n) % 32));
+    }
+  node->n_items += n;
+}
 
-      if (position == 0)
-        break;
+static void
+filter_node_remove (FilterNode *node,
+                    guint       offset,
+                    guint       n)
+{
+  guint i;
 
-      position--;
-      if (node->visible)
-        filtered++;
+  if (n == 0)
+    return;
 
-      node = gtk_rb_tree_node_get_right (node);
+  for (i = offset; i < offset + n; i++)
+    filter_node_set (node, i, FALSE);
+
+  for (i = offset + n; i < node->n_items; i++)
+    {
+      if (filter_node_get (node, i))
+        {
+          node->visible[(i - n) / 32] |= 1u << ((i - n) % 32);
+          node->visible[i / 32] &= ~(1u << (i % 32));
+        }
     }
+  node->n_items -= n;
+}
+
+typedef struct {
+  guint position;
+  guint before;
+} FilterFind;
+
+/* Finds the node containing the visible item at position */
+static gboolean
+gtk_filter_list_model_find_visible (GtkBTree *tree,
+                                    gpointer  _aug,
+                                    gpointer  _node,
+                                    gpointer  data)
+{
+  FilterAugment *aug = _aug;
+  FilterNode *node = _node;
+  FilterFind *find = data;
+  guint n_items, n_visible;
+
+  n_items = aug ? aug->n_items : node->n_items;
+  n_visible = aug ? aug->n_visible : node->n_visible;
+
+  if (find->position < n_visible)
+    return TRUE;
+
+  find->position -= n_visible;
+  find->before += n_items;
+  return FALSE;
+}
+
+/* Finds the node containing the item at position */
+static gboolean
+gtk_filter_list_model_find_item (GtkBTree *tree,
+                                 gpointer  _aug,
+                                 gpointer  _node,
+                                 gpointer  data)
+{
+  FilterAugment *aug = _aug;
+  FilterNode *node = _node;
+  FilterFind *find = data;
+  guint n_items, n_visible;
+
+  n_items = aug ? aug->n_items : node->n_items;
+  n_visible = aug ? aug->n_visible : node->n_visible;
+
+  if (find->position < n_items)
+    return TRUE;
+
+  find->position -= n_items;
+  find->before += n_visible;
+  return FALSE;
+}
 
+static guint
+gtk_filter_list_model_get_nth_filtered (GtkBTree *tree,
+                                        guint     position)
+{
+  FilterFind find = { position, 0 };
+  guint index;
+
+  index = gtk_btree_find (tree, gtk_filter_list_model_find_visible, &find);
+  if (index == gtk_btree_get_size (tree))
+    return find.before;
+
+  return find.before + filter_node_select (gtk_btree_get (tree, index), find.position);
+}
+
+/* Returns the index of the node containing the item at @position and
+ * the offset of the item in it, or the number of nodes if @position
+ * is past the end. */
+static guint
+gtk_filter_list_model_get_nth (GtkBTree *tree,
+                               guint     position,
+                               guint    *out_offset,
+                               guint    *out_filtered)
+{
+  FilterFind find = { position, 0 };
+  guint index;
+
+  index = gtk_btree_find (tree, gtk_filter_list_model_find_item, &find);
+  if (index < gtk_btree_get_size (tree))
+    find.before += filter_node_rank (gtk_btree_get (tree, index), find.position);
+
+  if (out_offset)
+    *out_offset = find.position;
   if (out_filtered)
-    *out_filtered = filtered;
+    *out_filtered = find.before;
 
-  return node;
+  return index;
 }
 
 static GType
@@ -178,7 +331,6 @@ gtk_filter_list_model_get_n_items (GListModel *list)
 {
   GtkFilterListModel *self = GTK_FILTER_LIST_MODEL (list);
   FilterAugment *aug;
-  FilterNode *node;
 
   if (self->model == NULL)
     return 0;
@@ -186,11 +338,10 @@ gtk_filter_list_model_get_n_items (GListModel *list)
   if (!self->items)
     return g_list_model_get_n_items (self->model);
 
-  node = gtk_rb_tree_get_root (self->items);
-  if (node == NULL)
+  aug = gtk_btree_get_augment (self->items);
+  if (aug == NULL)
     return 0;
 
-  aug = gtk_rb_tree_get_augment (self->items, node);
   return aug->n_visible;
 }
 
@@ -205,7 +356,7 @@ gtk_filter_list_model_get_item (GListModel *list,
     return NULL;
 
   if (self->items)
-    gtk_filter_list_model_get_nth_filtered (self->items, position, &unfiltered);
+    unfiltered = gtk_filter_list_model_get_nth_filtered (self->items, position);
   else
     unfiltered = position;
 
@@ -237,28 +388,264 @@ gtk_filter_list_model_run_filter (GtkFilterListModel *self,
   return visible;
 }
 
+/* Inserts @n_items items at @position. If @run_filter is %FALSE,
+ * they are all made visible. Returns the number of visible items. */
 static guint
 gtk_filter_list_model_add_items (GtkFilterListModel *self,
-                                 FilterNode         *after,
                                  guint               position,
-                                 guint               n_items)
+                                 guint               n_items,
+                                 gboolean            run_filter)
 {
-  FilterNode *node;
-  guint i, n_visible;
+  FilterNode *node, *split;
+  guint i, index, offset, n_nodes, n_visible;
+
+  if (n_items == 0)
+    return 0;
+
+  n_nodes = gtk_btree_get_size (self->items);
+  index = gtk_filter_list_model_get_nth (self->items, position, &offset, NULL);
+  if (index == n_nodes && n_nodes > 0)
+    {
+      index--;
+      node = gtk_btree_get (self->items, index);
+      offset = node->n_items;
+    }
+
+  if (n_nodes == 0)
+    {
+      node = gtk_btree_insert (self->items, 0, 1);
+    }
+  else
+    {
+      node = gtk_btree_get (self->items, index);
+      if (node->n_items + n_items > FILTER_CHUNK_SIZE && offset < node->n_items)
+        {
+          /* move the items after @offset to a node of their own, so the
+           * new items can be appended to @node */
+          split = gtk_btree_insert (self->items, index + 1, 1);
+          node = gtk_btree_get (self->items, index);
+          for (i = offset; i < node->n_items; i++)
+            filter_node_set (split, i - offset, filter_node_get (node, i));
+          split->n_items = node->n_items - offset;
+          filter_node_remove (node, offset, split->n_items);
+          gtk_btree_mark_dirty (self->items, index + 1);
+        }
+    }
+
+  /* insert all the nodes the new items need at once */
+  if (node->n_items + n_items > FILTER_CHUNK_SIZE)
+    {
+      n_nodes = n_items - (FILTER_CHUNK_SIZE - node->n_items);
+      gtk_btree_insert (self->items, index + 1, (n_nodes + FILTER_CHUNK_SIZE - 1) / FILTER_CHUNK_SIZE);
+      node = gtk_btree_get (self->items, index);
+    }
 
   n_visible = 0;
-  
-  for (i = 0; i < n_items; i++)
+  i = 0;
+  while (TRUE)
     {
-      node = gtk_rb_tree_insert_before (self->items, after);
-      node->visible = gtk_filter_list_model_run_filter (self, position + i);
-      if (node->visible)
-        n_visible++;
+      guint n = MIN (n_items - i, FILTER_CHUNK_SIZE - node->n_items);
+      guint j;
+
+      filter_node_insert (node, offset, n);
+      for (j = 0; j < n; j++)
+        {
+          gboolean visible;
+
+          if (run_filter)
+            visible = gtk_filter_list_model_run_filter (self, position + i + j);
+          else
+            visible = TRUE;
+
+          filter_node_set (node, offset + j, visible);
+          if (visible)
+            n_visible++;
+        }
+      gtk_btree_mark_dirty (self->items, index);
+
+      i += n;
+      if (i >= n_items)
+        break;
+
+      index++;
+      node = gtk_btree_get (self->items, index);
+      offset = 0;
     }
 
   return n_visible;
 }
 
+/* Runs the filter on the items in [start, end) and emits
+ * items-changed for the visible items that changed. */
+static void
+gtk_filter_list_model_refilter_range (GtkFilterListModel *self,
+                                      guint               start,
+                                      guint               end)
+{
+  FilterNode *node;
+  guint i, index, offset, filtered_start, first_change, last_change;
+  guint n_is_visible, n_was_visible;
+  gboolean visible;
+
+  if (start >= end)
+    return;
+
+  index = gtk_filter_list_model_get_nth (self->items, start, &offset, &filtered_start);
+
+  first_change = G_MAXUINT;
+  last_change = 0;
+  n_is_visible = 0;
+  n_was_visible = 0;
+  i = start;
+  while (i < end)
+    {
+      gboolean node_changed = FALSE;
+
+      node = gtk_btree_get (self->items, index);
+
+      for (; offset < node->n_items && i < end; offset++, i++)
+        {
+          visible = gtk_filter_list_model_run_filter (self, i);
+          if (visible == filter_node_get (node, offset))
+            {
+              if (visible)
+                {
+                  n_is_visible++;
+                  n_was_visible++;
+                }
+              continue;
+            }
+
+          filter_node_set (node, offset, visible);
+          node_changed = TRUE;
+          first_change = MIN (n_is_visible, first_change);
+          if (visible)
+            n_is_visible++;
+          else
+            n_was_visible++;
+          last_change = MAX (n_is_visible, last_change);
+        }
+
+      if (node_changed)
+        gtk_btree_mark_dirty (self->items, index);
+
+      index++;
+      offset = 0;
+    }
+
+  if (first_change <= last_change)
+    {
+      g_list_model_items_changed (G_LIST_MODEL (self),
+                                  filtered_start + first_change,
+                                  last_change - first_change + n_was_visible - n_is_visible,
+                                  last_change - first_change);
+    }
+}
+
+static void
+gtk_filter_list_model_set_pending (GtkFilterListModel *self,
+                                   guint               start,
+                                   guint               end);
+
+static gboolean
+gtk_filter_list_model_pending_cb (gpointer data)
+{
+  GtkFilterListModel *self = data;
+  guint source_id = self->pending_source_id;
+  gint64 end_time;
+
+  end_time = g_get_monotonic_time () + FILTER_INCREMENTAL_TIME_SLICE;
+
+  while (self->pending_start < self->pending_end)
+    {
+      guint start = self->pending_start;
+      guint end = MIN (self->pending_end, start + FILTER_CHUNK_SIZE);
+
+      /* Update the range first, items-changed handlers may change the model */
+      self->pending_start = end;
+      gtk_filter_list_model_refilter_range (self, start, end);
+
+      /* The filtering was cancelled or restarted by a handler */
+      if (self->pending_source_id != source_id)
+        return G_SOURCE_REMOVE;
+
+      if (g_get_monotonic_time () >= end_time)
+        break;
+    }
+
+  if (self->pending_start < self->pending_end)
+    {
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+      return G_SOURCE_CONTINUE;
+    }
+
+  self->pending_source_id = 0;
+  self->pending_start = 0;
+  self->pending_end = 0;
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_filter_list_model_set_pending (GtkFilterListModel *self,
+                                   guint               start,
+                                   guint               end)
+{
+  guint old_pending = self->pending_end - self->pending_start;
+
+  if (start >= end)
+    start = end = 0;
+
+  self->pending_start = start;
+  self->pending_end = end;
+
+  if (start < end && self->pending_source_id == 0)
+    {
+      self->pending_source_id = g_idle_add (gtk_filter_list_model_pending_cb, self);
+      g_source_set_name_by_id (self->pending_source_id, "[gtk] gtk_filter_list_model_pending_cb");
+    }
+  else if (start >= end && self->pending_source_id != 0)
+    {
+      g_source_remove (self->pending_source_id);
+      self->pending_source_id = 0;
+    }
+
+  if (old_pending != end - start)
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+}
+
+/* Keeps the pending range in sync with changes to the model. Items
+ * that replace pending ones are kept in the range, that's cheaper
+ * than being exact. */
+static void
+gtk_filter_list_model_update_pending (GtkFilterListModel *self,
+                                      guint               position,
+                                      guint               removed,
+                                      guint               added)
+{
+  guint start = self->pending_start;
+  guint end = self->pending_end;
+
+  if (start > position)
+    {
+      if (start >= position + removed)
+        start = start - removed + added;
+      else
+        start = position;
+    }
+
+  if (end > position)
+    {
+      if (end >= position + removed)
+        end = end - removed + added;
+      else
+        end = position + added;
+    }
+
+  gtk_filter_list_model_set_pending (self, start, end);
+}
+
 static void
 gtk_filter_list_model_items_changed_cb (GListModel         *model,
                                         guint               position,
@@ -266,8 +653,8 @@ gtk_filter_list_model_items_changed_cb (GListModel         *model,
                                         guint               added,
                                         GtkFilterListModel *self)
 {
-  FilterNode *node;
-  guint i, filter_position, filter_removed, filter_added;
+  guint index, offset, to_remove, n_empty;
+  guint filter_position, filter_removed, filter_added;
 
   if (self->items == NULL)
     {
@@ -275,19 +662,40 @@ gtk_filter_list_model_items_changed_cb (GListModel         *model,
       return;
     }
 
-  node = gtk_filter_list_model_get_nth (self->items, position, &filter_position);
+  index = gtk_filter_list_model_get_nth (self->items, position, &offset, &filter_position);
 
+  /* Nodes that become empty are consecutive and get removed at once.
+   * Only the first and last node can keep some of their items. */
   filter_removed = 0;
-  for (i = 0; i < removed; i++)
+  n_empty = 0;
+  for (to_remove = removed; to_remove > 0;)
     {
-      FilterNode *next = gtk_rb_tree_node_get_next (node);
-      if (node->visible)
-        filter_removed++;
-      gtk_rb_tree_remove (self->items, node);
-      node = next;
+      FilterNode *node = gtk_btree_get (self->items, index + n_empty);
+      guint n = MIN (to_remove, node->n_items - offset);
+
+      filter_removed += node->n_visible;
+      if (n == node->n_items)
+        {
+          n_empty++;
+        }
+      else
+        {
+          filter_node_remove (node, offset, n);
+          filter_removed -= node->n_visible;
+          gtk_btree_mark_dirty (self->items, index + n_empty);
+          if (offset > 0)
+            index++;
+        }
+
+      to_remove -= n;
+      offset = 0;
     }
+  gtk_btree_remove (self->items, index, n_empty);
+
+  filter_added = gtk_filter_list_model_add_items (self, position, added, TRUE);
 
-  filter_added = gtk_filter_list_model_add_items (self, node, position, added);
+  if (self->pending_start < self->pending_end)
+    gtk_filter_list_model_update_pending (self, position, removed, added);
 
   if (filter_removed > 0 || filter_added > 0)
     g_list_model_items_changed (G_LIST_MODEL (self), filter_position, filter_removed, filter_added);
@@ -303,6 +711,10 @@ gtk_filter_list_model_set_property (GObject      *object,
 
   switch (prop_id)
     {
+    case PROP_INCREMENTAL:
+      gtk_filter_list_model_set_incremental (self, g_value_get_boolean (value));
+      break;
+
     case PROP_ITEM_TYPE:
       self->item_type = g_value_get_gtype (value);
       break;
@@ -331,6 +743,10 @@ gtk_filter_list_model_get_property (GObject     *object,
       g_value_set_boolean (value, self->items != NULL);
       break;
 
+    case PROP_INCREMENTAL:
+      g_value_set_boolean (value, self->incremental);
+      break;
+
     case PROP_ITEM_TYPE:
       g_value_set_gtype (value, self->item_type);
       break;
@@ -339,6 +755,10 @@ gtk_filter_list_model_get_property (GObject     *object,
       g_value_set_object (value, self->model);
       break;
 
+    case PROP_PENDING:
+      g_value_set_uint (value, gtk_filter_list_model_get_pending (self));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -354,7 +774,8 @@ gtk_filter_list_model_clear_model (GtkFilterListModel *self)
   g_signal_handlers_disconnect_by_func (self->model, gtk_filter_list_model_items_changed_cb, self);
   g_clear_object (&self->model);
   if (self->items)
-    gtk_rb_tree_remove_all (self->items);
+    gtk_btree_remove_all (self->items);
+  gtk_filter_list_model_set_pending (self, 0, 0);
 }
 
 static void
@@ -368,7 +789,7 @@ gtk_filter_list_model_dispose (GObject *object)
   self->filter_func = NULL;
   self->user_data = NULL;
   self->user_destroy = NULL;
-  g_clear_pointer (&self->items, gtk_rb_tree_unref);
+  g_clear_pointer (&self->items, gtk_btree_unref);
 
   G_OBJECT_CLASS (gtk_filter_list_model_parent_class)->dispose (object);
 }
@@ -394,6 +815,18 @@ gtk_filter_list_model_class_init (GtkFilterListModelClass *class)
                             FALSE,
                             GTK_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * GtkFilterListModel:incremental:
+   *
+   * If the model should filter items incrementally
+   */
+  properties[PROP_INCREMENTAL] =
+      g_param_spec_boolean ("incremental",
+                            P_("Incremental"),
+                            P_("Filter items incrementally"),
+                            FALSE,
+                            GTK_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+
   /**
    * GtkFilterListModel:item-type:
    *
@@ -418,6 +851,18 @@ gtk_filter_list_model_class_init (GtkFilterListModelClass *class)
                            G_TYPE_LIST_MODEL,
                            GTK_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * GtkFilterListModel:pending:
+   *
+   * Number of items not yet filtered
+   */
+  properties[PROP_PENDING] =
+      g_param_spec_uint ("pending",
+                         P_("Pending"),
+                         P_("Number of items not yet filtered"),
+                         0, G_MAXUINT, 0,
+                         GTK_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 }
 
@@ -428,29 +873,42 @@ gtk_filter_list_model_init (GtkFilterListModel *self)
 
 
 static void
-gtk_filter_list_model_augment (GtkRbTree *filter,
-                               gpointer   _aug,
-                               gpointer   _node,
-                               gpointer   left,
-                               gpointer   right)
+gtk_filter_list_model_augment (GtkBTree *tree,
+                               gpointer  _aug,
+                               gpointer  _nodes,
+                               guint     n_nodes)
 {
-  FilterNode *node = _node;
   FilterAugment *aug = _aug;
+  FilterNode *nodes = _nodes;
+  guint i;
 
-  aug->n_items = 1;
-  aug->n_visible = node->visible ? 1 : 0;
+  aug->n_items = 0;
+  aug->n_visible = 0;
 
-  if (left)
+  for (i = 0; i < n_nodes; i++)
     {
-      FilterAugment *left_aug = gtk_rb_tree_get_augment (filter, left);
-      aug->n_items += left_aug->n_items;
-      aug->n_visible += left_aug->n_visible;
+      aug->n_items += nodes[i].n_items;
+      aug->n_visible += nodes[i].n_visible;
     }
-  if (right)
+}
+
+static void
+gtk_filter_list_model_combine (GtkBTree *tree,
+                               gpointer  _aug,
+                               gpointer  _augs,
+                               guint     n_augs)
+{
+  FilterAugment *aug = _aug;
+  FilterAugment *augs = _augs;
+  guint i;
+
+  aug->n_items = 0;
+  aug->n_visible = 0;
+
+  for (i = 0; i < n_augs; i++)
     {
-      FilterAugment *right_aug = gtk_rb_tree_get_augment (filter, right);
-      aug->n_items += right_aug->n_items;
-      aug->n_visible += right_aug->n_visible;
+      aug->n_items += augs[i].n_items;
+      aug->n_visible += augs[i].n_visible;
     }
 }
 
@@ -543,25 +1001,18 @@ gtk_filter_list_model_set_filter_func (GtkFilterListModel           *self,
   
   if (!will_be_filtered)
     {
-      g_clear_pointer (&self->items, gtk_rb_tree_unref);
+      gtk_filter_list_model_set_pending (self, 0, 0);
+      g_clear_pointer (&self->items, gtk_btree_unref);
     }
   else if (!was_filtered)
     {
-      guint i, n_items;
-
-      self->items = gtk_rb_tree_new (FilterNode,
-                                     FilterAugment,
-                                     gtk_filter_list_model_augment,
-                                     NULL, NULL);
+      self->items = gtk_btree_new (FilterNode,
+                                   FilterAugment,
+                                   gtk_filter_list_model_augment,
+                                   gtk_filter_list_model_combine,
+                                   NULL);
       if (self->model)
-        {
-          n_items = g_list_model_get_n_items (self->model);
-          for (i = 0; i < n_items; i++)
-            {
-              FilterNode *node = gtk_rb_tree_insert_before (self->items, NULL);
-              node->visible = TRUE;
-            }
-        }
+        gtk_filter_list_model_add_items (self, 0, g_list_model_get_n_items (self->model), FALSE);
     }
 
   gtk_filter_list_model_refilter (self);
@@ -603,8 +1054,13 @@ gtk_filter_list_model_set_model (GtkFilterListModel *self,
     {
       self->model = g_object_ref (model);
       g_signal_connect (model, "items-changed", G_CALLBACK (gtk_filter_list_model_items_changed_cb), self);
-      if (self->items)
-        added = gtk_filter_list_model_add_items (self, NULL, 0, g_list_model_get_n_items (model));
+      if (self->items && self->incremental)
+        {
+          added = gtk_filter_list_model_add_items (self, 0, g_list_model_get_n_items (model), FALSE);
+          gtk_filter_list_model_set_pending (self, 0, added);
+        }
+      else if (self->items)
+        added = gtk_filter_list_model_add_items (self, 0, g_list_model_get_n_items (model), TRUE);
       else
         added = g_list_model_get_n_items (model);
     }
@@ -657,55 +1113,103 @@ gtk_filter_list_model_has_filter (GtkFilterListModel *self)
  *
  * Calling this function is necessary when data used by the filter
  * function has changed.
+ *
+ * If @self is incremental, this only schedules the refiltering and
+ * cancels any refiltering that was still pending.
  **/
 void
 gtk_filter_list_model_refilter (GtkFilterListModel *self)
 {
-  FilterNode *node;
-  guint i, first_change, last_change;
-  guint n_is_visible, n_was_visible;
-  gboolean visible;
-
   g_return_if_fail (GTK_IS_FILTER_LIST_MODEL (self));
   
   if (self->items == NULL || self->model == NULL)
     return;
 
-  first_change = G_MAXUINT;
-  last_change = 0;
-  n_is_visible = 0;
-  n_was_visible = 0;
-  for (i = 0, node = gtk_rb_tree_get_first (self->items);
-       node != NULL;
-       i++, node = gtk_rb_tree_node_get_next (node))
+  if (self->incremental)
     {
-      visible = gtk_filter_list_model_run_filter (self, i);
-      if (visible == node->visible)
-        {
-          if (visible)
-            {
-              n_is_visible++;
-              n_was_visible++;
-            }
-          continue;
-        }
-
-      node->visible = visible;
-      gtk_rb_tree_node_mark_dirty (node);
-      first_change = MIN (n_is_visible, first_change);
-      if (visible)
-        n_is_visible++;
-      else
-        n_was_visible++;
-      last_change = MAX (n_is_visible, last_change);
+      gtk_filter_list_model_set_pending (self, 0, g_list_model_get_n_items (self->model));
     }
+  else
+    {
+      gtk_filter_list_model_set_pending (self, 0, 0);
+      gtk_filter_list_model_refilter_range (self, 0, g_list_model_get_n_items (self->model));
+    }
+}
 
-  if (first_change <= last_change)
+/**
+ * gtk_filter_list_model_set_incremental:
+ * @self: a #GtkFilterListModel
+ * @incremental: %TRUE to filter incrementally
+ *
+ * Sets the filter model to do an incremental filtering.
+ *
+ * When filtering incrementally, the filter function is not run over
+ * the whole model at once. Instead, the items are filtered in small
+ * batches from an idle handler and #GListModel::items-changed is
+ * emitted for every batch. Items that have not been filtered yet keep
+ * their previous visibility, new items are visible until they are
+ * filtered.
+ *
+ * Changing the filter while a filtering is in progress cancels it and
+ * starts over.
+ *
+ * Use gtk_filter_list_model_get_pending() to find out about the
+ * progress.
+ **/
+void
+gtk_filter_list_model_set_incremental (GtkFilterListModel *self,
+                                       gboolean            incremental)
+{
+  g_return_if_fail (GTK_IS_FILTER_LIST_MODEL (self));
+
+  if (self->incremental == incremental)
+    return;
+
+  self->incremental = incremental;
+
+  if (!incremental && self->pending_start < self->pending_end)
     {
-      g_list_model_items_changed (G_LIST_MODEL (self),
-                                  first_change,
-                                  last_change - first_change + n_was_visible - n_is_visible,
-                                  last_change - first_change);
+      guint start = self->pending_start;
+      guint end = self->pending_end;
+
+      gtk_filter_list_model_set_pending (self, 0, 0);
+      gtk_filter_list_model_refilter_range (self, start, end);
     }
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_INCREMENTAL]);
+}
+
+/**
+ * gtk_filter_list_model_get_incremental:
+ * @self: a #GtkFilterListModel
+ *
+ * Returns whether incremental filtering was enabled via
+ * gtk_filter_list_model_set_incremental().
+ *
+ * Returns: %TRUE if incremental filtering is enabled
+ **/
+gboolean
+gtk_filter_list_model_get_incremental (GtkFilterListModel *self)
+{
+  g_return_val_if_fail (GTK_IS_FILTER_LIST_MODEL (self), FALSE);
+
+  return self->incremental;
 }
 
+/**
+ * gtk_filter_list_model_get_pending:
+ * @self: a #GtkFilterListModel
+ *
+ * Returns the number of items that have not been filtered yet.
+ *
+ * This is always 0 unless the model is incremental.
+ *
+ * Returns: the number of items not yet filtered
+ **/
+guint
+gtk_filter_list_model_get_pending (GtkFilterListModel *self)
+{
+  g_return_val_if_fail (GTK_IS_FILTER_LIST_MODEL (self), 0);
+
+  return self->pending_end - self->pending_start;
+}
@@ -72,6 +72,13 @@ gboolean                gtk_filter_list_model_has_filter        (GtkFilterListMo
 
 GDK_AVAILABLE_IN_ALL
 void                    gtk_filter_list_model_refilter          (GtkFilterListModel     *self);
+GDK_AVAILABLE_IN_ALL
+void                    gtk_filter_list_model_set_incremental   (GtkFilterListModel     *self,
+                                                                 gboolean                incremental);
+GDK_AVAILABLE_IN_ALL
+gboolean                gtk_filter_list_model_get_incremental   (GtkFilterListModel     *self);
+GDK_AVAILABLE_IN_ALL
+guint                   gtk_filter_list_model_get_pending       (GtkFilterListModel     *self);
 
 G_END_DECLS
 
@@ -128,6 +128,8 @@ static void gtk_flow_box_set_accept_unpaired_release (GtkFlowBox *box,
                                                       gboolean    accept);
 
 static void gtk_flow_box_check_model_compat  (GtkFlowBox *box);
+static guint gtk_flow_box_get_first_bound    (GtkFlowBox *box);
+static void gtk_flow_box_queue_update_bound_children (GtkFlowBox *box);
 
 static void
 get_current_selection_modifiers (GtkWidget *widget,
@@ -493,7 +495,7 @@ gtk_flow_box_child_get_index (GtkFlowBoxChild *child)
   priv = CHILD_PRIV (child);
 
   if (priv->iter != NULL)
-    return g_sequence_iter_get_position (priv->iter);
+    return g_sequence_iter_get_position (priv->iter) + gtk_flow_box_get_first_bound (gtk_flow_box_child_get_box (child));
 
   return -1;
 }
@@ -643,8 +645,18 @@ struct _GtkFlowBoxPrivate {
 
   GListModel                 *bound_model;
   GtkFlowBoxCreateWidgetFunc  create_widget_func;
+  GtkFlowBoxBindChildFunc     bind_child_func;
   gpointer                    create_widget_func_data;
   GDestroyNotify              create_widget_func_data_destroy;
+
+  /* Only the children for items [first_bound, first_bound + n_children)
+   * exist when bound with gtk_flow_box_bind_model_virtual() */
+  guint                       first_bound;
+  gint                        line_size_estimate;
+  GPtrArray                  *recycled_children;
+  guint                       update_bound_children_id;
+  /* Sorted positions of selected items that currently have no child */
+  GArray                     *selected_positions;
 };
 
 #define BOX_PRIV(box) ((GtkFlowBoxPrivate*)gtk_flow_box_get_instance_private ((GtkFlowBox*)(box)))
@@ -778,6 +790,13 @@ gtk_flow_box_unselect_all_internal (GtkFlowBox *box)
       dirty |= gtk_flow_box_child_set_selected (child, FALSE);
     }
 
+  if (BOX_PRIV (box)->selected_positions != NULL &&
+      BOX_PRIV (box)->selected_positions->len > 0)
+    {
+      g_array_set_size (BOX_PRIV (box)->selected_positions, 0);
+      dirty = TRUE;
+    }
+
   return dirty;
 }
 
@@ -1319,6 +1338,69 @@ fit_aligned_item_requests (GtkFlowBox     *box,
   return sizes;
 }
 
+/* Guesses how many items fit on a line from their natural size */
+static gint
+get_line_length_for_item_size (GtkFlowBox *box,
+                               gint        avail_size,
+                               gint        item_spacing,
+                               gint        nat_item_size)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  gint line_length;
+
+  /* By default flow at the natural item width */
+  line_length = avail_size / (nat_item_size + item_spacing);
+
+  /* After the above aproximation, check if we cant fit one more on the line */
+  if (line_length * item_spacing + (line_length + 1) * nat_item_size <= avail_size)
+    line_length++;
+
+  /* Its possible we were allocated just less than the natural width of the
+   * minimum item flow length
+   */
+  line_length = MAX (MAX (1, priv->min_children_per_line), line_length);
+  line_length = MIN (line_length, priv->max_children_per_line);
+
+  return line_length;
+}
+
+/* Gets the number of items per line that gtk_flow_box_size_allocate()
+ * will use for the current children when given @avail_size */
+static gint
+get_line_length (GtkFlowBox *box,
+                 gint        avail_size)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  GtkRequestedSize *item_sizes;
+  gint n_children, nat_item_size, item_spacing, line_length;
+
+  if (priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+    item_spacing = priv->column_spacing;
+  else
+    item_spacing = priv->row_spacing;
+
+  n_children = get_visible_children (box);
+  get_max_item_size (box, priv->orientation, NULL, &nat_item_size);
+  if (n_children <= 0 || nat_item_size <= 0)
+    return MAX (1, priv->min_children_per_line);
+
+  line_length = get_line_length_for_item_size (box, avail_size, item_spacing, nat_item_size);
+
+  if (!priv->homogeneous)
+    {
+      item_sizes = fit_aligned_item_requests (box,
+                                              priv->orientation,
+                                              avail_size,
+                                              item_spacing,
+                                              &line_length,
+                                              priv->max_children_per_line,
+                                              n_children);
+      g_free (item_sizes);
+    }
+
+  return line_length;
+}
+
 typedef struct {
   GArray *requested;
   gint    extra_pixels;
@@ -1359,7 +1441,7 @@ gtk_flow_box_size_allocate (GtkWidget *widget,
   GtkFlowBox *box = GTK_FLOW_BOX (widget);
   GtkFlowBoxPrivate  *priv = BOX_PRIV (box);
   GtkAllocation child_allocation;
-  gint avail_size, avail_other_size, min_items, item_spacing, line_spacing;
+  gint avail_size, avail_other_size, item_spacing, line_spacing;
   GtkAlign item_align;
   GtkAlign line_align;
   GtkRequestedSize *line_sizes = NULL;
@@ -1374,8 +1456,6 @@ gtk_flow_box_size_allocate (GtkWidget *widget,
   gint i, this_line_size;
   GSequenceIter *iter;
 
-  min_items = MAX (1, priv->min_children_per_line);
-
   if (priv->orientation == GTK_ORIENTATION_HORIZONTAL)
     {
       avail_size = width;
@@ -1405,18 +1485,7 @@ gtk_flow_box_size_allocate (GtkWidget *widget,
   if (nat_item_size <= 0)
     return;
 
-  /* By default flow at the natural item width */
-  line_length = avail_size / (nat_item_size + item_spacing);
-
-  /* After the above aproximation, check if we cant fit one more on the line */
-  if (line_length * item_spacing + (line_length + 1) * nat_item_size <= avail_size)
-    line_length++;
-
-  /* Its possible we were allocated just less than the natural width of the
-   * minimum item flow length
-   */
-  line_length = MAX (min_items, line_length);
-  line_length = MIN (line_length, priv->max_children_per_line);
+  line_length = get_line_length_for_item_size (box, avail_size, item_spacing, nat_item_size);
 
   /* Here we just use the largest height-for-width and use that for the height
    * of all lines
@@ -1429,6 +1498,11 @@ gtk_flow_box_size_allocate (GtkWidget *widget,
 
       n_lines = MAX (n_lines, 1);
 
+      /* The lines for items without children are accounted for by
+       * line_offset, so only use the estimated size of the others */
+      if (priv->bind_child_func != NULL)
+        avail_other_size = n_lines * (priv->line_size_estimate + line_spacing) - line_spacing;
+
       /* Now we need the real item allocation size */
       item_size = (avail_size - (line_length - 1) * item_spacing) / line_length;
 
@@ -1475,6 +1549,9 @@ gtk_flow_box_size_allocate (GtkWidget *widget,
       n_lines = MAX (n_lines, 1);
       line_sizes = g_new0 (GtkRequestedSize, n_lines);
 
+      if (priv->bind_child_func != NULL)
+        avail_other_size = n_lines * (priv->line_size_estimate + line_spacing) - line_spacing;
+
       /* Get the available remaining size */
       avail_size -= (line_length - 1) * item_spacing;
       for (i = 0; i < line_length; i++)
@@ -1554,6 +1631,15 @@ gtk_flow_box_size_allocate (GtkWidget *widget,
   item_offset = get_offset_pixels (item_align, extra_pixels);
   line_offset = get_offset_pixels (line_align, extra_line_pixels);
 
+  if (priv->bind_child_func != NULL)
+    {
+      line_offset += priv->first_bound / line_length * (priv->line_size_estimate + line_spacing);
+
+      /* The children must start a line, or the lines change when scrolling */
+      if (priv->first_bound % line_length != 0)
+        gtk_flow_box_queue_update_bound_children (box);
+    }
+
   /* Get the allocation size for the first line */
   if (priv->homogeneous)
     this_line_size = line_size;
@@ -1788,6 +1874,28 @@ gtk_flow_box_measure (GtkWidget      *widget,
   GtkFlowBox *box = GTK_FLOW_BOX (widget);
   GtkFlowBoxPrivate *priv = BOX_PRIV (box);
 
+  /* When only some items have children, all lines are assumed
+   * to be of the estimated size */
+  if (priv->bind_child_func != NULL && orientation != priv->orientation)
+    {
+      gint line_length, line_spacing, n_lines;
+
+      if (priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+        line_spacing = priv->row_spacing;
+      else
+        line_spacing = priv->column_spacing;
+
+      if (for_size < 0)
+        line_length = MAX (1, priv->min_children_per_line);
+      else
+        line_length = get_line_length (box, for_size);
+
+      n_lines = (g_list_model_get_n_items (priv->bound_model) + line_length - 1) / line_length;
+
+      *minimum = *natural = MAX (0, n_lines * (priv->line_size_estimate + line_spacing) - line_spacing);
+      return;
+    }
+
   if (orientation == GTK_ORIENTATION_HORIZONTAL)
     {
       if (for_size < 0)
@@ -3344,8 +3452,16 @@ gtk_flow_box_finalize (GObject *obj)
     priv->sort_destroy (priv->sort_data);
 
   g_sequence_free (priv->children);
-  g_clear_object (&priv->hadjustment);
-  g_clear_object (&priv->vadjustment);
+  if (priv->hadjustment)
+    {
+      g_signal_handlers_disconnect_by_func (priv->hadjustment, gtk_flow_box_queue_update_bound_children, obj);
+      g_clear_object (&priv->hadjustment);
+    }
+  if (priv->vadjustment)
+    {
+      g_signal_handlers_disconnect_by_func (priv->vadjustment, gtk_flow_box_queue_update_bound_children, obj);
+      g_clear_object (&priv->vadjustment);
+    }
 
   if (priv->bound_model)
     {
@@ -3356,6 +3472,11 @@ gtk_flow_box_finalize (GObject *obj)
       g_clear_object (&priv->bound_model);
     }
 
+  if (priv->update_bound_children_id != 0)
+    g_source_remove (priv->update_bound_children_id);
+  g_clear_pointer (&priv->recycled_children, g_ptr_array_unref);
+  g_clear_pointer (&priv->selected_positions, g_array_unref);
+
   G_OBJECT_CLASS (gtk_flow_box_parent_class)->finalize (obj);
 }
 
@@ -3746,31 +3867,79 @@ gtk_flow_box_init (GtkFlowBox *box)
   gtk_widget_add_controller (GTK_WIDGET (box), controller);
 }
 
+static guint
+gtk_flow_box_get_first_bound (GtkFlowBox *box)
+{
+  return BOX_PRIV (box)->first_bound;
+}
+
+/* Returns the index in selected_positions of the first
+ * position >= @position */
+static guint
+gtk_flow_box_find_selected_position (GtkFlowBox *box,
+                                     guint       position)
+{
+  GArray *positions = BOX_PRIV (box)->selected_positions;
+  guint min, max, mid;
+
+  min = 0;
+  max = positions->len;
+  while (min < max)
+    {
+      mid = (min + max) / 2;
+      if (g_array_index (positions, guint, mid) < position)
+        min = mid + 1;
+      else
+        max = mid;
+    }
+
+  return min;
+}
+
+/* Adjusts the positions of selected items without a child to
+ * a change of the model. Returns %TRUE if a selected item
+ * was removed. */
+static gboolean
+gtk_flow_box_update_selected_positions (GtkFlowBox *box,
+                                        guint       position,
+                                        guint       removed,
+                                        guint       added)
+{
+  GArray *positions = BOX_PRIV (box)->selected_positions;
+  guint i, start, end;
+
+  start = gtk_flow_box_find_selected_position (box, position);
+  end = gtk_flow_box_find_selected_position (box, position + removed);
+  g_array_remove_range (positions, start, end - start);
+
+  for (i = start; i < positions->len; i++)
+    g_array_index (positions, guint, i) += added - removed;
+
+  return end > start;
+}
+
+/* Inserts a child for the item at @position in the model at @index in
+ * the list of children, reusing a recycled child if there is one. */
 static void
-gtk_flow_box_bound_model_changed (GListModel *list,
-                                  guint       position,
-                                  guint       removed,
-                                  guint       added,
-                                  gpointer    user_data)
+gtk_flow_box_insert_bound_item (GtkFlowBox *box,
+                                guint       position,
+                                gint        index)
 {
-  GtkFlowBox *box = user_data;
   GtkFlowBoxPrivate *priv = BOX_PRIV (box);
-  gint i;
+  GObject *item;
+  GtkWidget *widget;
 
-  while (removed--)
+  item = g_list_model_get_item (priv->bound_model, position);
+
+  if (priv->recycled_children != NULL && priv->recycled_children->len > 0)
     {
-      GtkFlowBoxChild *child;
+      widget = g_object_ref (g_ptr_array_index (priv->recycled_children, priv->recycled_children->len - 1));
+      g_ptr_array_remove_index (priv->recycled_children, priv->recycled_children->len - 1);
 
-      child = gtk_flow_box_get_child_at_index (box, position);
-      gtk_widget_destroy (GTK_WIDGET (child));
+      priv->bind_child_func (GTK_FLOW_BOX_CHILD (widget), item, priv->create_widget_func_data);
     }
-
-  for (i = 0; i < added; i++)
+  else
     {
-      GObject *item;
-      GtkWidget *widget;
-
-      item = g_list_model_get_item (list, position + i);
       widget = priv->create_widget_func (item, priv->create_widget_func_data);
 
       /* We need to sink the floating reference here, so that we can accept
@@ -3779,17 +3948,269 @@ gtk_flow_box_bound_model_changed (GListModel *list,
        * from language bindings which will automatically sink the floating
        * reference).
        *
-       * See the similar code in gtklistbox.c:gtk_list_box_bound_model_changed.
+       * See the similar code in gtklistbox.c:gtk_list_box_insert_bound_item.
        */
       if (g_object_is_floating (widget))
         g_object_ref_sink (widget);
 
       gtk_widget_show (widget);
-      gtk_flow_box_insert (box, widget, position + i);
+    }
+
+  gtk_flow_box_insert (box, widget, index);
+
+  /* Restore the selection the item had when its child was recycled */
+  if (priv->selected_positions != NULL)
+    {
+      guint i = gtk_flow_box_find_selected_position (box, position);
+
+      if (i < priv->selected_positions->len &&
+          g_array_index (priv->selected_positions, guint, i) == position)
+        {
+          g_array_remove_index (priv->selected_positions, i);
+          gtk_flow_box_child_set_selected (GTK_FLOW_BOX_CHILD (widget), TRUE);
+          priv->selected_child = GTK_FLOW_BOX_CHILD (widget);
+        }
+    }
+
+  g_object_unref (widget);
+  g_object_unref (item);
+}
+
+/* Removes @n_children children starting at @index and keeps them
+ * around for gtk_flow_box_insert_bound_item().
+ *
+ * The selection moves from the children to selected_positions without
+ * emitting any signals, the items are still selected. */
+static void
+gtk_flow_box_recycle_children (GtkFlowBox *box,
+                               guint       index,
+                               guint       n_children)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  GSequenceIter *iter;
+
+  iter = g_sequence_get_iter_at_pos (priv->children, index);
+  for (; n_children > 0; n_children--, index++)
+    {
+      GtkFlowBoxChild *child = g_sequence_get (iter);
+
+      iter = g_sequence_iter_next (iter);
+
+      if (CHILD_PRIV (child)->selected)
+        {
+          guint position = priv->first_bound + index;
+
+          g_array_insert_val (priv->selected_positions,
+                              gtk_flow_box_find_selected_position (box, position),
+                              position);
+          gtk_flow_box_child_set_selected (child, FALSE);
+        }
+
+      g_ptr_array_add (priv->recycled_children, g_object_ref (child));
+      gtk_container_remove (GTK_CONTAINER (box), GTK_WIDGET (child));
+    }
+}
+
+/* Makes the children for the items [first, last) exist and no others */
+static void
+gtk_flow_box_set_bound_range (GtkFlowBox *box,
+                              guint       first,
+                              guint       last)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  guint i, old_first, old_last;
 
-      g_object_unref (widget);
-      g_object_unref (item);
+  old_first = priv->first_bound;
+  old_last = old_first + g_sequence_get_length (priv->children);
+
+  if (first >= old_last || last <= old_first)
+    {
+      gtk_flow_box_recycle_children (box, 0, old_last - old_first);
+      old_first = old_last = first;
     }
+  else
+    {
+      if (last < old_last)
+        {
+          gtk_flow_box_recycle_children (box, last - old_first, old_last - last);
+          old_last = last;
+        }
+      if (first > old_first)
+        {
+          gtk_flow_box_recycle_children (box, 0, first - old_first);
+          old_first = first;
+        }
+    }
+
+  priv->first_bound = old_first;
+  for (i = old_first; i > first; i--)
+    {
+      gtk_flow_box_insert_bound_item (box, i - 1, 0);
+      priv->first_bound = i - 1;
+    }
+  for (i = old_last; i < last; i++)
+    gtk_flow_box_insert_bound_item (box, i, -1);
+}
+
+/* All lines are assumed to be as large as the largest child
+ * that exists, the same way homogeneous boxes are laid out */
+static void
+gtk_flow_box_update_line_size_estimate (GtkFlowBox *box)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  gint estimate;
+
+  if (get_visible_children (box) == 0)
+    return;
+
+  get_largest_size_for_opposing_orientation (box, priv->orientation, -1, NULL, &estimate);
+
+  estimate = MAX (1, estimate);
+  if (estimate != priv->line_size_estimate)
+    {
+      priv->line_size_estimate = estimate;
+      gtk_widget_queue_resize (GTK_WIDGET (box));
+    }
+}
+
+static void
+gtk_flow_box_update_bound_children (GtkFlowBox *box)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  GtkAdjustment *adjustment;
+  guint n_items, line_length, first_line, last_line;
+  gint line_spacing;
+  double value, page_size;
+
+  n_items = g_list_model_get_n_items (priv->bound_model);
+
+  if (priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+    {
+      adjustment = priv->vadjustment;
+      line_spacing = priv->row_spacing;
+    }
+  else
+    {
+      adjustment = priv->hadjustment;
+      line_spacing = priv->column_spacing;
+    }
+
+  if (adjustment == NULL)
+    {
+      /* Without scrolling, all children are visible */
+      gtk_flow_box_set_bound_range (box, 0, n_items);
+    }
+  else
+    {
+      if (priv->line_size_estimate == 0)
+        {
+          gtk_flow_box_set_bound_range (box, 0, MIN (n_items, 1));
+          gtk_flow_box_update_line_size_estimate (box);
+        }
+
+      if (priv->line_size_estimate > 0)
+        {
+          if (priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+            line_length = get_line_length (box, gtk_widget_get_width (GTK_WIDGET (box)));
+          else
+            line_length = get_line_length (box, gtk_widget_get_height (GTK_WIDGET (box)));
+
+          value = gtk_adjustment_get_value (adjustment);
+          page_size = gtk_adjustment_get_page_size (adjustment);
+
+          /* Keep half a page of lines around in both directions, so that
+           * scrolling doesn't show missing children before the next update.
+           * Only whole lines are bound, so that the lines stay the same
+           * while scrolling. */
+          first_line = MAX (0, value - page_size / 2) / (priv->line_size_estimate + line_spacing);
+          last_line = (value + page_size * 3 / 2) / (priv->line_size_estimate + line_spacing) + 1;
+
+          gtk_flow_box_set_bound_range (box,
+                                        MIN (n_items, first_line * line_length),
+                                        MIN (n_items, last_line * line_length));
+        }
+    }
+
+  gtk_flow_box_update_line_size_estimate (box);
+
+  g_ptr_array_set_size (priv->recycled_children, 0);
+}
+
+static gboolean
+gtk_flow_box_update_bound_children_cb (gpointer data)
+{
+  GtkFlowBox *box = data;
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+
+  priv->update_bound_children_id = 0;
+
+  gtk_flow_box_update_bound_children (box);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_flow_box_queue_update_bound_children (GtkFlowBox *box)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+
+  if (priv->bind_child_func == NULL || priv->update_bound_children_id != 0)
+    return;
+
+  priv->update_bound_children_id = g_idle_add_full (GTK_PRIORITY_RESIZE - 2,
+                                                    gtk_flow_box_update_bound_children_cb,
+                                                    box, NULL);
+  g_source_set_name_by_id (priv->update_bound_children_id, "[gtk+] gtk_flow_box_update_bound_children_cb");
+}
+
+static void
+gtk_flow_box_bound_model_changed (GListModel *list,
+                                  guint       position,
+                                  guint       removed,
+                                  guint       added,
+                                  gpointer    user_data)
+{
+  GtkFlowBox *box = user_data;
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  gint i;
+
+  if (priv->bind_child_func != NULL)
+    {
+      guint first = priv->first_bound;
+      guint last = first + g_sequence_get_length (priv->children);
+
+      /* Get rid of the children for removed items and keep the remaining
+       * ones contiguous, the idle update fills the gaps and realigns
+       * the children to the start of a line. */
+      if (position < first)
+        {
+          if (position + removed > first)
+            gtk_flow_box_recycle_children (box, 0, MIN (position + removed, last) - first);
+          priv->first_bound = MAX (first, position + removed) + added - removed;
+        }
+      else if (position < last)
+        {
+          gtk_flow_box_recycle_children (box, position - first, last - position);
+        }
+
+      if (gtk_flow_box_update_selected_positions (box, position, removed, added))
+        g_signal_emit (box, signals[SELECTED_CHILDREN_CHANGED], 0);
+
+      gtk_flow_box_queue_update_bound_children (box);
+      gtk_widget_queue_resize (GTK_WIDGET (box));
+      return;
+    }
+
+  while (removed--)
+    {
+      GtkFlowBoxChild *child;
+
+      child = gtk_flow_box_get_child_at_index (box, position);
+      gtk_widget_destroy (GTK_WIDGET (child));
+    }
+
+  for (i = 0; i < added; i++)
+    gtk_flow_box_insert_bound_item (box, position + i, position + i);
 }
 
  /* Public API {{{2 */
@@ -3900,11 +4321,15 @@ GtkFlowBoxChild *
 gtk_flow_box_get_child_at_index (GtkFlowBox *box,
                                  gint        idx)
 {
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
   GSequenceIter *iter;
 
   g_return_val_if_fail (GTK_IS_FLOW_BOX (box), NULL);
 
-  iter = g_sequence_get_iter_at_pos (BOX_PRIV (box)->children, idx);
+  if (idx < (gint) priv->first_bound)
+    return NULL;
+
+  iter = g_sequence_get_iter_at_pos (priv->children, idx - priv->first_bound);
   if (!g_sequence_iter_is_end (iter))
     return g_sequence_get (iter);
 
@@ -3979,9 +4404,18 @@ gtk_flow_box_set_hadjustment (GtkFlowBox    *box,
 
   g_object_ref (adjustment);
   if (priv->hadjustment)
-    g_object_unref (priv->hadjustment);
+    {
+      g_signal_handlers_disconnect_by_func (priv->hadjustment, gtk_flow_box_queue_update_bound_children, box);
+      g_object_unref (priv->hadjustment);
+    }
   priv->hadjustment = adjustment;
   gtk_container_set_focus_hadjustment (GTK_CONTAINER (box), adjustment);
+
+  g_signal_connect_swapped (adjustment, "value-changed",
+                            G_CALLBACK (gtk_flow_box_queue_update_bound_children), box);
+  g_signal_connect_swapped (adjustment, "changed",
+                            G_CALLBACK (gtk_flow_box_queue_update_bound_children), box);
+  gtk_flow_box_queue_update_bound_children (box);
 }
 
 /**
@@ -4014,9 +4448,18 @@ gtk_flow_box_set_vadjustment (GtkFlowBox    *box,
 
   g_object_ref (adjustment);
   if (priv->vadjustment)
-    g_object_unref (priv->vadjustment);
+    {
+      g_signal_handlers_disconnect_by_func (priv->vadjustment, gtk_flow_box_queue_update_bound_children, box);
+      g_object_unref (priv->vadjustment);
+    }
   priv->vadjustment = adjustment;
   gtk_container_set_focus_vadjustment (GTK_CONTAINER (box), adjustment);
+
+  g_signal_connect_swapped (adjustment, "value-changed",
+                            G_CALLBACK (gtk_flow_box_queue_update_bound_children), box);
+  g_signal_connect_swapped (adjustment, "changed",
+                            G_CALLBACK (gtk_flow_box_queue_update_bound_children), box);
+  gtk_flow_box_queue_update_bound_children (box);
 }
 
 static void
@@ -4029,6 +4472,61 @@ gtk_flow_box_check_model_compat (GtkFlowBox *box)
     g_warning ("GtkFlowBox with a model will ignore sort and filter functions");
 }
 
+static void
+gtk_flow_box_bind_model_internal (GtkFlowBox                 *box,
+                                  GListModel                 *model,
+                                  GtkFlowBoxCreateWidgetFunc  create_widget_func,
+                                  GtkFlowBoxBindChildFunc     bind_child_func,
+                                  gpointer                    user_data,
+                                  GDestroyNotify              user_data_free_func)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+
+  if (priv->bound_model)
+    {
+      if (priv->create_widget_func_data_destroy)
+        priv->create_widget_func_data_destroy (priv->create_widget_func_data);
+
+      g_signal_handlers_disconnect_by_func (priv->bound_model, gtk_flow_box_bound_model_changed, box);
+      g_clear_object (&priv->bound_model);
+    }
+
+  if (priv->update_bound_children_id != 0)
+    {
+      g_source_remove (priv->update_bound_children_id);
+      priv->update_bound_children_id = 0;
+    }
+  g_clear_pointer (&priv->recycled_children, g_ptr_array_unref);
+  g_clear_pointer (&priv->selected_positions, g_array_unref);
+  priv->bind_child_func = NULL;
+  priv->first_bound = 0;
+  priv->line_size_estimate = 0;
+
+  gtk_flow_box_forall (GTK_CONTAINER (box), (GtkCallback) gtk_widget_destroy, NULL);
+
+  if (model == NULL)
+    return;
+
+  priv->bound_model = g_object_ref (model);
+  priv->create_widget_func = create_widget_func;
+  priv->bind_child_func = bind_child_func;
+  priv->create_widget_func_data = user_data;
+  priv->create_widget_func_data_destroy = user_data_free_func;
+
+  gtk_flow_box_check_model_compat (box);
+
+  g_signal_connect (priv->bound_model, "items-changed", G_CALLBACK (gtk_flow_box_bound_model_changed), box);
+
+  if (bind_child_func != NULL)
+    {
+      priv->recycled_children = g_ptr_array_new_with_free_func (g_object_unref);
+      priv->selected_positions = g_array_new (FALSE, FALSE, sizeof (guint));
+      gtk_flow_box_update_bound_children (box);
+    }
+  else
+    gtk_flow_box_bound_model_changed (model, 0, 0, g_list_model_get_n_items (model), box);
+}
+
 /**
  * gtk_flow_box_bind_model:
  * @box: a #GtkFlowBox
@@ -4053,6 +4551,8 @@ gtk_flow_box_check_model_compat (GtkFlowBox *box)
  * Note that using a model is incompatible with the filtering and sorting
  * functionality in GtkFlowBox. When using a model, filtering and sorting
  * should be implemented by the model.
+ *
+ * For large models, consider gtk_flow_box_bind_model_virtual().
  */
 void
 gtk_flow_box_bind_model (GtkFlowBox                 *box,
@@ -4061,35 +4561,65 @@ gtk_flow_box_bind_model (GtkFlowBox                 *box,
                          gpointer                    user_data,
                          GDestroyNotify              user_data_free_func)
 {
-  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
-
   g_return_if_fail (GTK_IS_FLOW_BOX (box));
   g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
   g_return_if_fail (model == NULL || create_widget_func != NULL);
 
-  if (priv->bound_model)
-    {
-      if (priv->create_widget_func_data_destroy)
-        priv->create_widget_func_data_destroy (priv->create_widget_func_data);
-
-      g_signal_handlers_disconnect_by_func (priv->bound_model, gtk_flow_box_bound_model_changed, box);
-      g_clear_object (&priv->bound_model);
-    }
-
-  gtk_flow_box_forall (GTK_CONTAINER (box), (GtkCallback) gtk_widget_destroy, NULL);
-
-  if (model == NULL)
-    return;
-
-  priv->bound_model = g_object_ref (model);
-  priv->create_widget_func = create_widget_func;
-  priv->create_widget_func_data = user_data;
-  priv->create_widget_func_data_destroy = user_data_free_func;
+  gtk_flow_box_bind_model_internal (box, model, create_widget_func, NULL, user_data, user_data_free_func);
+}
 
-  gtk_flow_box_check_model_compat (box);
+/**
+ * gtk_flow_box_bind_model_virtual:
+ * @box: a #GtkFlowBox
+ * @model: (nullable): the #GListModel to be bound to @box
+ * @create_widget_func: (nullable): a function that creates widgets for items
+ *   or %NULL in case you also passed %NULL as @model
+ * @bind_child_func: (nullable): a function that makes an existing child
+ *   represent a different item or %NULL in case you also passed %NULL
+ *   as @model
+ * @user_data: user data passed to @create_widget_func and @bind_child_func
+ * @user_data_free_func: function for freeing @user_data
+ *
+ * Binds @model to @box like gtk_flow_box_bind_model(), but only creates
+ * children for the lines that are in view or close to it, so the cost of
+ * a bound @box depends on the size of the view and not on the size of
+ * @model.
+ *
+ * When @box is scrolled, children that leave the view are passed to
+ * @bind_child_func to be reused for the items that come into view.
+ * @create_widget_func is only called when no such child is available.
+ *
+ * All lines are assumed to be as large as the largest child that
+ * exists, and the number of children per line is determined from the
+ * existing children, too. So scrolling to any position, for example
+ * with gtk_adjustment_set_value(), only creates the children for the
+ * lines at that position.
+ *
+ * Children are only created for the visible area if the adjustment that
+ * scrolls the lines of @box is set with gtk_flow_box_set_vadjustment()
+ * (or gtk_flow_box_set_hadjustment() for a vertical @box).
+ * gtk_flow_box_get_child_at_index() returns %NULL for items that have
+ * no child.
+ *
+ * Items keep their selection when their child goes away, and their
+ * child is selected again when they get one.
+ * gtk_flow_box_get_selected_children() and gtk_flow_box_selected_foreach()
+ * skip selected items that have no child.
+ */
+void
+gtk_flow_box_bind_model_virtual (GtkFlowBox                 *box,
+                                 GListModel                 *model,
+                                 GtkFlowBoxCreateWidgetFunc  create_widget_func,
+                                 GtkFlowBoxBindChildFunc     bind_child_func,
+                                 gpointer                    user_data,
+                                 GDestroyNotify              user_data_free_func)
+{
+  g_return_if_fail (GTK_IS_FLOW_BOX (box));
+  g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
+  g_return_if_fail (model == NULL || create_widget_func != NULL);
+  g_return_if_fail (model == NULL || bind_child_func != NULL);
 
-  g_signal_connect (priv->bound_model, "items-changed", G_CALLBACK (gtk_flow_box_bound_model_changed), box);
-  gtk_flow_box_bound_model_changed (model, 0, 0, g_list_model_get_n_items (model), box);
+  gtk_flow_box_bind_model_internal (box, model, create_widget_func, bind_child_func, user_data, user_data_free_func);
 }
 
 /* Setters and getters {{{2 */
@@ -112,6 +112,23 @@ struct _GtkFlowBoxChildClass
 typedef GtkWidget * (*GtkFlowBoxCreateWidgetFunc) (gpointer item,
                                                    gpointer  user_data);
 
+/**
+ * GtkFlowBoxBindChildFunc:
+ * @child: a child that was previously created for a different item
+ * @item: (type GObject): the item from the model that @child should now represent
+ * @user_data: (closure): user data from gtk_flow_box_bind_model_virtual()
+ *
+ * Called for flow boxes that are bound to a #GListModel with
+ * gtk_flow_box_bind_model_virtual() when a child that was scrolled
+ * out of view is reused for another item.
+ *
+ * If the create function returned a widget that is not a
+ * #GtkFlowBoxChild, it can be found with gtk_bin_get_child().
+ */
+typedef void (*GtkFlowBoxBindChildFunc) (GtkFlowBoxChild *child,
+                                         gpointer         item,
+                                         gpointer         user_data);
+
 GDK_AVAILABLE_IN_ALL
 GType                 gtk_flow_box_child_get_type            (void) G_GNUC_CONST;
 GDK_AVAILABLE_IN_ALL
@@ -136,6 +153,13 @@ void                  gtk_flow_box_bind_model                (GtkFlowBox
                                                               GtkFlowBoxCreateWidgetFunc  create_widget_func,
                                                               gpointer                    user_data,
                                                               GDestroyNotify              user_data_free_func);
+GDK_AVAILABLE_IN_ALL
+void                  gtk_flow_box_bind_model_virtual        (GtkFlowBox                 *box,
+                                                              GListModel                 *model,
+                                                              GtkFlowBoxCreateWidgetFunc  create_widget_func,
+                                                              GtkFlowBoxBindChildFunc     bind_child_func,
+                                                              gpointer                    user_data,
+                                                              GDestroyNotify              user_data_free_func);
 
 GDK_AVAILABLE_IN_ALL
 void                  gtk_flow_box_set_homogeneous           (GtkFlowBox           *box,
@@ -250,6 +250,8 @@
  * the #GtkLabel::activate-link signal and the gtk_label_get_current_uri() function.
  */
 
+#define N_MEASURING_LAYOUTS 3
+
 struct _GtkLabelPrivate
 {
   GtkLabelSelectionInfo *select_info;
@@ -259,6 +261,8 @@ struct _GtkLabelPrivate
   PangoAttrList *attrs;
   PangoAttrList *markup_attrs;
   PangoLayout   *layout;
+  /* Copies of layout used for measuring other widths, most recently used first */
+  PangoLayout   *measuring_layouts[N_MEASURING_LAYOUTS];
 
   gchar   *label;
   gchar   *text;
@@ -3171,7 +3175,7 @@ gtk_label_finalize (GObject *object)
   g_free (priv->label);
   g_free (priv->text);
 
-  g_clear_object (&priv->layout);
+  gtk_label_clear_layout (label);
   g_clear_pointer (&priv->attrs, pango_attr_list_unref);
   g_clear_pointer (&priv->markup_attrs, pango_attr_list_unref);
 
@@ -3186,12 +3190,78 @@ gtk_label_finalize (GObject *object)
   G_OBJECT_CLASS (gtk_label_parent_class)->finalize (object);
 }
 
+static void
+gtk_label_clear_measuring_layouts (GtkLabel *label)
+{
+  GtkLabelPrivate *priv = gtk_label_get_instance_private (label);
+  guint i;
+
+  for (i = 0; i < N_MEASURING_LAYOUTS; i++)
+    g_clear_object (&priv->measuring_layouts[i]);
+}
+
 static void
 gtk_label_clear_layout (GtkLabel *label)
 {
   GtkLabelPrivate *priv = gtk_label_get_instance_private (label);
 
   g_clear_object (&priv->layout);
+  gtk_label_clear_measuring_layouts (label);
+}
+
+/* Returns a copy of the label's layout with the given width, reusing
+ * one of the copies made for earlier measurements if possible. Size
+ * negotiation tends to ask for the same few widths over and over.
+ */
+static PangoLayout *
+gtk_label_get_measuring_layout_copy (GtkLabel *label,
+                                     int       width)
+{
+  GtkLabelPrivate *priv = gtk_label_get_instance_private (label);
+  PangoLayout *layout;
+  guint i;
+
+  for (i = 0; i < N_MEASURING_LAYOUTS; i++)
+    {
+      layout = priv->measuring_layouts[i];
+      if (layout == NULL)
+        break;
+
+      if (pango_layout_get_width (layout) == width)
+        {
+          memmove (&priv->measuring_layouts[1], &priv->measuring_layouts[0], i * sizeof (PangoLayout *));
+          priv->measuring_layouts[0] = layout;
+          return g_object_ref (layout);
+        }
+    }
+
+  g_clear_object (&priv->measuring_layouts[N_MEASURING_LAYOUTS - 1]);
+  memmove (&priv->measuring_layouts[1], &priv->measuring_layouts[0], (N_MEASURING_LAYOUTS - 1) * sizeof (PangoLayout *));
+
+  layout = pango_layout_copy (priv->layout);
+  pango_layout_set_width (layout, width);
+  priv->measuring_layouts[0] = layout;
+
+  return g_object_ref (layout);
+}
+
+static gboolean
+gtk_label_is_measuring_layout (GtkLabel    *label,
+                               PangoLayout *layout)
+{
+  GtkLabelPrivate *priv = gtk_label_get_instance_private (label);
+  guint i;
+
+  if (layout == priv->layout)
+    return TRUE;
+
+  for (i = 0; i < N_MEASURING_LAYOUTS; i++)
+    {
+      if (layout == priv->measuring_layouts[i])
+        return TRUE;
+    }
+
+  return FALSE;
 }
 
 /**
@@ -3214,11 +3284,10 @@ gtk_label_get_measuring_layout (GtkLabel *   label,
 {
   GtkLabelPrivate *priv = gtk_label_get_instance_private (label);
   PangoRectangle rect;
-  PangoLayout *copy;
 
   if (existing_layout != NULL)
     {
-      if (existing_layout != priv->layout)
+      if (!gtk_label_is_measuring_layout (label, existing_layout))
         {
           pango_layout_set_width (existing_layout, width);
           return existing_layout;
@@ -3260,9 +3329,7 @@ gtk_label_get_measuring_layout (GtkLabel *   label,
       return priv->layout;
     }
 
-  copy = pango_layout_copy (priv->layout);
-  pango_layout_set_width (copy, width);
-  return copy;
+  return gtk_label_get_measuring_layout_copy (label, width);
 }
 
 static void
@@ -3277,6 +3344,9 @@ gtk_label_update_layout_attributes (GtkLabel *label)
   if (priv->layout == NULL)
     return;
 
+  /* The copies would keep the old attributes */
+  gtk_label_clear_measuring_layouts (label);
+
   context = gtk_widget_get_style_context (widget);
 
   if (priv->select_info && priv->select_info->links)
@@ -3574,8 +3644,6 @@ gtk_label_measure (GtkWidget      *widget,
 
   if (orientation == GTK_ORIENTATION_VERTICAL && for_size != -1 && priv->wrap)
     {
-      gtk_label_clear_layout (label);
-
       get_height_for_width (label, for_size, minimum, natural, minimum_baseline, natural_baseline);
     }
   else
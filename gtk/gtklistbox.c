@@ -121,8 +121,18 @@ typedef struct
 
   GListModel *bound_model;
   GtkListBoxCreateWidgetFunc create_widget_func;
+  GtkListBoxBindRowFunc bind_row_func;
   gpointer create_widget_func_data;
   GDestroyNotify create_widget_func_data_destroy;
+
+  /* Only the rows for items [first_bound, first_bound + n_children)
+   * exist when bound with gtk_list_box_bind_model_virtual() */
+  guint first_bound;
+  int row_height_estimate;
+  GPtrArray *recycled_rows;
+  guint update_bound_rows_id;
+  /* Sorted positions of selected items that currently have no row */
+  GArray *selected_positions;
 } GtkListBoxPrivate;
 
 typedef struct
@@ -284,6 +294,7 @@ static void                 gtk_list_box_bound_model_changed            (GListMo
                                                                          gpointer             user_data);
 
 static void                 gtk_list_box_check_model_compat             (GtkListBox          *box);
+static void                 gtk_list_box_queue_update_bound_rows        (GtkListBox          *box);
 
 static void gtk_list_box_measure (GtkWidget     *widget,
                                   GtkOrientation  orientation,
@@ -375,7 +386,11 @@ gtk_list_box_finalize (GObject *obj)
   if (priv->update_header_func_target_destroy_notify != NULL)
     priv->update_header_func_target_destroy_notify (priv->update_header_func_target);
 
-  g_clear_object (&priv->adjustment);
+  if (priv->adjustment)
+    {
+      g_signal_handlers_disconnect_by_func (priv->adjustment, gtk_list_box_queue_update_bound_rows, obj);
+      g_clear_object (&priv->adjustment);
+    }
   g_clear_object (&priv->drag_highlighted_row);
 
   g_sequence_free (priv->children);
@@ -390,6 +405,11 @@ gtk_list_box_finalize (GObject *obj)
       g_clear_object (&priv->bound_model);
     }
 
+  if (priv->update_bound_rows_id != 0)
+    g_source_remove (priv->update_bound_rows_id);
+  g_clear_pointer (&priv->recycled_rows, g_ptr_array_unref);
+  g_clear_pointer (&priv->selected_positions, g_array_unref);
+
   G_OBJECT_CLASS (gtk_list_box_parent_class)->finalize (obj);
 }
 
@@ -673,11 +693,15 @@ GtkListBoxRow *
 gtk_list_box_get_row_at_index (GtkListBox *box,
                                gint        index_)
 {
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
   GSequenceIter *iter;
 
   g_return_val_if_fail (GTK_IS_LIST_BOX (box), NULL);
 
-  iter = g_sequence_get_iter_at_pos (BOX_PRIV (box)->children, index_);
+  if (index_ < (gint) priv->first_bound)
+    return NULL;
+
+  iter = g_sequence_get_iter_at_pos (priv->children, index_ - priv->first_bound);
   if (!g_sequence_iter_is_end (iter))
     return g_sequence_get (iter);
 
@@ -957,8 +981,21 @@ gtk_list_box_set_adjustment (GtkListBox    *box,
   if (adjustment)
     g_object_ref_sink (adjustment);
   if (priv->adjustment)
-    g_object_unref (priv->adjustment);
+    {
+      g_signal_handlers_disconnect_by_func (priv->adjustment, gtk_list_box_queue_update_bound_rows, box);
+      g_object_unref (priv->adjustment);
+    }
   priv->adjustment = adjustment;
+
+  if (adjustment)
+    {
+      g_signal_connect_swapped (adjustment, "value-changed",
+                                G_CALLBACK (gtk_list_box_queue_update_bound_rows), box);
+      g_signal_connect_swapped (adjustment, "changed",
+                                G_CALLBACK (gtk_list_box_queue_update_bound_rows), box);
+    }
+
+  gtk_list_box_queue_update_bound_rows (box);
 }
 
 /**
@@ -1531,6 +1568,13 @@ gtk_list_box_unselect_all_internal (GtkListBox *box)
       dirty |= gtk_list_box_row_set_selected (row, FALSE);
     }
 
+  if (BOX_PRIV (box)->selected_positions != NULL &&
+      BOX_PRIV (box)->selected_positions->len > 0)
+    {
+      g_array_set_size (BOX_PRIV (box)->selected_positions, 0);
+      dirty = TRUE;
+    }
+
   BOX_PRIV (box)->selected_row = NULL;
 
   return dirty;
@@ -2496,6 +2540,11 @@ gtk_list_box_measure (GtkWidget     *widget,
           *minimum += row_min;
         }
 
+      /* Rows that don't exist are assumed to be of average height */
+      if (priv->bind_row_func != NULL)
+        *minimum += (g_list_model_get_n_items (priv->bound_model) - g_sequence_get_length (priv->children))
+                    * priv->row_height_estimate;
+
       /* We always allocate the minimum height, since handling expanding rows
        * is way too costly, and unlikely to be used, as lists are generally put
        * inside a scrolling window anyway.
@@ -2539,6 +2588,9 @@ gtk_list_box_size_allocate (GtkWidget *widget,
       child_allocation.y += child_min;
     }
 
+  if (priv->bind_row_func != NULL)
+    child_allocation.y += priv->first_bound * priv->row_height_estimate;
+
   for (iter = g_sequence_get_begin_iter (priv->children);
        !g_sequence_iter_is_end (iter);
        iter = g_sequence_iter_next (iter))
@@ -3091,7 +3143,11 @@ gtk_list_box_row_get_index (GtkListBoxRow *row)
   priv = ROW_PRIV (row);
 
   if (priv->iter != NULL)
-    return g_sequence_iter_get_position (priv->iter);
+    {
+      GtkListBox *box = gtk_list_box_row_get_box (row);
+
+      return g_sequence_iter_get_position (priv->iter) + BOX_PRIV (box)->first_bound;
+    }
 
   return -1;
 }
@@ -3477,31 +3533,73 @@ gtk_list_box_buildable_interface_init (GtkBuildableIface *iface)
   iface->add_child = gtk_list_box_buildable_add_child;
 }
 
-static void
-gtk_list_box_bound_model_changed (GListModel *list,
-                                  guint       position,
-                                  guint       removed,
-                                  guint       added,
-                                  gpointer    user_data)
+/* Returns the index in selected_positions of the first
+ * position >= @position */
+static guint
+gtk_list_box_find_selected_position (GtkListBox *box,
+                                     guint       position)
 {
-  GtkListBox *box = user_data;
-  GtkListBoxPrivate *priv = BOX_PRIV (user_data);
-  guint i;
+  GArray *positions = BOX_PRIV (box)->selected_positions;
+  guint min, max, mid;
 
-  while (removed--)
+  min = 0;
+  max = positions->len;
+  while (min < max)
     {
-      GtkListBoxRow *row;
-
-      row = gtk_list_box_get_row_at_index (box, position);
-      gtk_container_remove (GTK_CONTAINER (box), GTK_WIDGET (row));
+      mid = (min + max) / 2;
+      if (g_array_index (positions, guint, mid) < position)
+        min = mid + 1;
+      else
+        max = mid;
     }
 
-  for (i = 0; i < added; i++)
+  return min;
+}
+
+/* Adjusts the positions of selected items without a row to
+ * a change of the model. Returns %TRUE if a selected item
+ * was removed. */
+static gboolean
+gtk_list_box_update_selected_positions (GtkListBox *box,
+                                        guint       position,
+                                        guint       removed,
+                                        guint       added)
+{
+  GArray *positions = BOX_PRIV (box)->selected_positions;
+  guint i, start, end;
+
+  start = gtk_list_box_find_selected_position (box, position);
+  end = gtk_list_box_find_selected_position (box, position + removed);
+  g_array_remove_range (positions, start, end - start);
+
+  for (i = start; i < positions->len; i++)
+    g_array_index (positions, guint, i) += added - removed;
+
+  return end > start;
+}
+
+/* Inserts a row for the item at @position in the model at @index in
+ * the list of rows, reusing a recycled row if there is one. */
+static void
+gtk_list_box_insert_bound_item (GtkListBox *box,
+                                guint       position,
+                                gint        index)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  GObject *item;
+  GtkWidget *widget;
+
+  item = g_list_model_get_item (priv->bound_model, position);
+
+  if (priv->recycled_rows != NULL && priv->recycled_rows->len > 0)
     {
-      GObject *item;
-      GtkWidget *widget;
+      widget = g_object_ref (g_ptr_array_index (priv->recycled_rows, priv->recycled_rows->len - 1));
+      g_ptr_array_remove_index (priv->recycled_rows, priv->recycled_rows->len - 1);
 
-      item = g_list_model_get_item (list, position + i);
+      priv->bind_row_func (GTK_LIST_BOX_ROW (widget), item, priv->create_widget_func_data);
+    }
+  else
+    {
       widget = priv->create_widget_func (item, priv->create_widget_func_data);
 
       /* We allow the create_widget_func to either return a full
@@ -3515,11 +3613,270 @@ gtk_list_box_bound_model_changed (GListModel *list,
         g_object_ref_sink (widget);
 
       gtk_widget_show (widget);
-      gtk_list_box_insert (box, widget, position + i);
+    }
+
+  gtk_list_box_insert (box, widget, index);
+
+  /* Restore the selection the item had when its row was recycled */
+  if (priv->selected_positions != NULL)
+    {
+      guint i = gtk_list_box_find_selected_position (box, position);
+
+      if (i < priv->selected_positions->len &&
+          g_array_index (priv->selected_positions, guint, i) == position)
+        {
+          g_array_remove_index (priv->selected_positions, i);
+          gtk_list_box_row_set_selected (GTK_LIST_BOX_ROW (widget), TRUE);
+          priv->selected_row = GTK_LIST_BOX_ROW (widget);
+        }
+    }
+
+  g_object_unref (widget);
+  g_object_unref (item);
+}
+
+/* Removes @n_rows rows starting at @index and keeps them
+ * around for gtk_list_box_insert_bound_item().
+ *
+ * The selection moves from the rows to selected_positions without
+ * emitting any signals, the items are still selected. */
+static void
+gtk_list_box_recycle_rows (GtkListBox *box,
+                           guint       index,
+                           guint       n_rows)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  GSequenceIter *iter;
+
+  iter = g_sequence_get_iter_at_pos (priv->children, index);
+  for (; n_rows > 0; n_rows--, index++)
+    {
+      GtkListBoxRow *row = g_sequence_get (iter);
+
+      iter = g_sequence_iter_next (iter);
+
+      if (ROW_PRIV (row)->selected)
+        {
+          guint position = priv->first_bound + index;
+
+          g_array_insert_val (priv->selected_positions,
+                              gtk_list_box_find_selected_position (box, position),
+                              position);
+          gtk_list_box_row_set_selected (row, FALSE);
+        }
+
+      g_ptr_array_add (priv->recycled_rows, g_object_ref (row));
+      gtk_container_remove (GTK_CONTAINER (box), GTK_WIDGET (row));
+    }
+}
+
+/* Makes the rows for the items [first, last) exist and no others */
+static void
+gtk_list_box_set_bound_range (GtkListBox *box,
+                              guint       first,
+                              guint       last)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  guint i, old_first, old_last;
+
+  old_first = priv->first_bound;
+  old_last = old_first + g_sequence_get_length (priv->children);
+
+  if (first >= old_last || last <= old_first)
+    {
+      gtk_list_box_recycle_rows (box, 0, old_last - old_first);
+      old_first = old_last = first;
+    }
+  else
+    {
+      if (last < old_last)
+        {
+          gtk_list_box_recycle_rows (box, last - old_first, old_last - last);
+          old_last = last;
+        }
+      if (first > old_first)
+        {
+          gtk_list_box_recycle_rows (box, 0, first - old_first);
+          old_first = first;
+        }
+    }
+
+  priv->first_bound = old_first;
+  for (i = old_first; i > first; i--)
+    {
+      gtk_list_box_insert_bound_item (box, i - 1, 0);
+      priv->first_bound = i - 1;
+    }
+  for (i = old_last; i < last; i++)
+    gtk_list_box_insert_bound_item (box, i, -1);
+}
+
+static void
+gtk_list_box_update_row_height_estimate (GtkListBox *box)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  GSequenceIter *iter;
+  int width, total, n_rows, estimate;
+
+  width = gtk_widget_get_width (GTK_WIDGET (box));
+  total = 0;
+  n_rows = 0;
+
+  for (iter = g_sequence_get_begin_iter (priv->children);
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    {
+      GtkListBoxRow *row = g_sequence_get (iter);
+      int row_min;
+
+      if (!row_is_visible (row))
+        continue;
+
+      if (ROW_PRIV (row)->header != NULL)
+        {
+          gtk_widget_measure (ROW_PRIV (row)->header, GTK_ORIENTATION_VERTICAL,
+                              width > 0 ? width : -1,
+                              &row_min, NULL, NULL, NULL);
+          total += row_min;
+        }
+      gtk_widget_measure (GTK_WIDGET (row), GTK_ORIENTATION_VERTICAL,
+                          width > 0 ? width : -1,
+                          &row_min, NULL, NULL, NULL);
+      total += row_min;
+      n_rows++;
+    }
+
+  if (n_rows == 0)
+    return;
+
+  estimate = MAX (1, (total + n_rows / 2) / n_rows);
+  if (estimate != priv->row_height_estimate)
+    {
+      priv->row_height_estimate = estimate;
+      gtk_widget_queue_resize (GTK_WIDGET (box));
+    }
+}
+
+static void
+gtk_list_box_update_bound_rows (GtkListBox *box)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  guint n_items, first, last;
+  double value, page_size;
+
+  n_items = g_list_model_get_n_items (priv->bound_model);
+
+  if (priv->adjustment == NULL)
+    {
+      /* Without scrolling, all rows are visible */
+      gtk_list_box_set_bound_range (box, 0, n_items);
+    }
+  else
+    {
+      if (priv->row_height_estimate == 0)
+        {
+          gtk_list_box_set_bound_range (box, 0, MIN (n_items, 1));
+          gtk_list_box_update_row_height_estimate (box);
+        }
+
+      if (priv->row_height_estimate > 0)
+        {
+          value = gtk_adjustment_get_value (priv->adjustment);
+          page_size = gtk_adjustment_get_page_size (priv->adjustment);
+
+          /* Keep half a page of rows around in both directions, so that
+           * scrolling doesn't show missing rows before the next update */
+          first = CLAMP ((value - page_size / 2) / priv->row_height_estimate, 0, n_items);
+          last = CLAMP (ceil ((value + page_size * 3 / 2) / priv->row_height_estimate), first, n_items);
+          if (last == first && last < n_items)
+            last++;
+
+          gtk_list_box_set_bound_range (box, first, last);
+        }
+    }
+
+  gtk_list_box_update_row_height_estimate (box);
+
+  g_ptr_array_set_size (priv->recycled_rows, 0);
+}
+
+static gboolean
+gtk_list_box_update_bound_rows_cb (gpointer data)
+{
+  GtkListBox *box = data;
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+
+  priv->update_bound_rows_id = 0;
+
+  gtk_list_box_update_bound_rows (box);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_list_box_queue_update_bound_rows (GtkListBox *box)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+
+  if (priv->bind_row_func == NULL || priv->update_bound_rows_id != 0)
+    return;
 
-      g_object_unref (widget);
-      g_object_unref (item);
+  priv->update_bound_rows_id = g_idle_add_full (GTK_PRIORITY_RESIZE - 2,
+                                                gtk_list_box_update_bound_rows_cb,
+                                                box, NULL);
+  g_source_set_name_by_id (priv->update_bound_rows_id, "[gtk+] gtk_list_box_update_bound_rows_cb");
+}
+
+static void
+gtk_list_box_bound_model_changed (GListModel *list,
+                                  guint       position,
+                                  guint       removed,
+                                  guint       added,
+                                  gpointer    user_data)
+{
+  GtkListBox *box = user_data;
+  GtkListBoxPrivate *priv = BOX_PRIV (user_data);
+  guint i;
+
+  if (priv->bind_row_func != NULL)
+    {
+      guint first = priv->first_bound;
+      guint last = first + g_sequence_get_length (priv->children);
+
+      /* Get rid of the rows for removed items and keep the remaining
+       * ones contiguous, the idle update fills the gaps. */
+      if (position < first)
+        {
+          if (position + removed > first)
+            gtk_list_box_recycle_rows (box, 0, MIN (position + removed, last) - first);
+          priv->first_bound = MAX (first, position + removed) + added - removed;
+        }
+      else if (position < last)
+        {
+          gtk_list_box_recycle_rows (box, position - first, last - position);
+        }
+
+      if (gtk_list_box_update_selected_positions (box, position, removed, added))
+        {
+          g_signal_emit (box, signals[ROW_SELECTED], 0, NULL);
+          g_signal_emit (box, signals[SELECTED_ROWS_CHANGED], 0);
+        }
+
+      gtk_list_box_queue_update_bound_rows (box);
+      gtk_widget_queue_resize (GTK_WIDGET (box));
+      return;
+    }
+
+  while (removed--)
+    {
+      GtkListBoxRow *row;
+
+      row = gtk_list_box_get_row_at_index (box, position);
+      gtk_container_remove (GTK_CONTAINER (box), GTK_WIDGET (row));
     }
+
+  for (i = 0; i < added; i++)
+    gtk_list_box_insert_bound_item (box, position + i, position + i);
 }
 
 static void
@@ -3532,6 +3889,69 @@ gtk_list_box_check_model_compat (GtkListBox *box)
     g_warning ("GtkListBox with a model will ignore sort and filter functions");
 }
 
+static void
+gtk_list_box_bind_model_internal (GtkListBox                 *box,
+                                  GListModel                 *model,
+                                  GtkListBoxCreateWidgetFunc  create_widget_func,
+                                  GtkListBoxBindRowFunc       bind_row_func,
+                                  gpointer                    user_data,
+                                  GDestroyNotify              user_data_free_func)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  GSequenceIter *iter;
+
+  if (priv->bound_model)
+    {
+      if (priv->create_widget_func_data_destroy)
+        priv->create_widget_func_data_destroy (priv->create_widget_func_data);
+
+      g_signal_handlers_disconnect_by_func (priv->bound_model, gtk_list_box_bound_model_changed, box);
+      g_clear_object (&priv->bound_model);
+    }
+
+  if (priv->update_bound_rows_id != 0)
+    {
+      g_source_remove (priv->update_bound_rows_id);
+      priv->update_bound_rows_id = 0;
+    }
+  g_clear_pointer (&priv->recycled_rows, g_ptr_array_unref);
+  g_clear_pointer (&priv->selected_positions, g_array_unref);
+  priv->bind_row_func = NULL;
+  priv->first_bound = 0;
+  priv->row_height_estimate = 0;
+
+  iter = g_sequence_get_begin_iter (priv->children);
+  while (!g_sequence_iter_is_end (iter))
+    {
+      GtkWidget *row = g_sequence_get (iter);
+      iter = g_sequence_iter_next (iter);
+      gtk_list_box_remove (GTK_CONTAINER (box), row);
+    }
+
+
+  if (model == NULL)
+    return;
+
+  priv->bound_model = g_object_ref (model);
+  priv->create_widget_func = create_widget_func;
+  priv->bind_row_func = bind_row_func;
+  priv->create_widget_func_data = user_data;
+  priv->create_widget_func_data_destroy = user_data_free_func;
+
+  gtk_list_box_check_model_compat (box);
+
+  g_signal_connect (priv->bound_model, "items-changed", G_CALLBACK (gtk_list_box_bound_model_changed), box);
+
+  if (bind_row_func != NULL)
+    {
+      priv->recycled_rows = g_ptr_array_new_with_free_func (g_object_unref);
+      priv->selected_positions = g_array_new (FALSE, FALSE, sizeof (guint));
+      gtk_list_box_update_bound_rows (box);
+    }
+  else
+    gtk_list_box_bound_model_changed (model, 0, 0, g_list_model_get_n_items (model), box);
+}
+
 /**
  * gtk_list_box_bind_model:
  * @box: a #GtkListBox
@@ -3557,6 +3977,8 @@ gtk_list_box_check_model_compat (GtkListBox *box)
  * Note that using a model is incompatible with the filtering and sorting
  * functionality in GtkListBox. When using a model, filtering and sorting
  * should be implemented by the model.
+ *
+ * For large models, consider gtk_list_box_bind_model_virtual().
  */
 void
 gtk_list_box_bind_model (GtkListBox                 *box,
@@ -3565,41 +3987,60 @@ gtk_list_box_bind_model (GtkListBox                 *box,
                          gpointer                    user_data,
                          GDestroyNotify              user_data_free_func)
 {
-  GtkListBoxPrivate *priv = BOX_PRIV (box);
-  GSequenceIter *iter;
-
   g_return_if_fail (GTK_IS_LIST_BOX (box));
   g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
   g_return_if_fail (model == NULL || create_widget_func != NULL);
 
-  if (priv->bound_model)
-    {
-      if (priv->create_widget_func_data_destroy)
-        priv->create_widget_func_data_destroy (priv->create_widget_func_data);
-
-      g_signal_handlers_disconnect_by_func (priv->bound_model, gtk_list_box_bound_model_changed, box);
-      g_clear_object (&priv->bound_model);
-    }
-
-  iter = g_sequence_get_begin_iter (priv->children);
-  while (!g_sequence_iter_is_end (iter))
-    {
-      GtkWidget *row = g_sequence_get (iter);
-      iter = g_sequence_iter_next (iter);
-      gtk_list_box_remove (GTK_CONTAINER (box), row);
-    }
-
-
-  if (model == NULL)
-    return;
-
-  priv->bound_model = g_object_ref (model);
-  priv->create_widget_func = create_widget_func;
-  priv->create_widget_func_data = user_data;
-  priv->create_widget_func_data_destroy = user_data_free_func;
+  gtk_list_box_bind_model_internal (box, model, create_widget_func, NULL, user_data, user_data_free_func);
+}
 
-  gtk_list_box_check_model_compat (box);
+/**
+ * gtk_list_box_bind_model_virtual:
+ * @box: a #GtkListBox
+ * @model: (nullable): the #GListModel to be bound to @box
+ * @create_widget_func: (nullable): a function that creates widgets for items
+ *   or %NULL in case you also passed %NULL as @model
+ * @bind_row_func: (nullable): a function that makes an existing row
+ *   represent a different item or %NULL in case you also passed %NULL
+ *   as @model
+ * @user_data: user data passed to @create_widget_func and @bind_row_func
+ * @user_data_free_func: function for freeing @user_data
+ *
+ * Binds @model to @box like gtk_list_box_bind_model(), but only creates
+ * rows for the items that are in view or close to it, so the cost of a
+ * bound @box depends on the size of the view and not on the size of
+ * @model.
+ *
+ * When @box is scrolled, rows that leave the view are passed to
+ * @bind_row_func to be reused for the items that come into view.
+ * @create_widget_func is only called when no such row is available.
+ *
+ * The height of items without a row is estimated from the rows that
+ * exist, so the scrollbar will only be approximate if rows differ in
+ * height.
+ *
+ * Rows are only created for the visible area if @box is put into a
+ * #GtkScrollable like #GtkViewport or has an adjustment set with
+ * gtk_list_box_set_adjustment(). gtk_list_box_get_row_at_index()
+ * returns %NULL for items that have no row.
+ *
+ * Items keep their selection when their row goes away, and their row
+ * is selected again when they get one. gtk_list_box_get_selected_row(),
+ * gtk_list_box_get_selected_rows() and gtk_list_box_selected_foreach()
+ * only report selected items that currently have a row.
+ */
+void
+gtk_list_box_bind_model_virtual (GtkListBox                 *box,
+                                 GListModel                 *model,
+                                 GtkListBoxCreateWidgetFunc  create_widget_func,
+                                 GtkListBoxBindRowFunc       bind_row_func,
+                                 gpointer                    user_data,
+                                 GDestroyNotify              user_data_free_func)
+{
+  g_return_if_fail (GTK_IS_LIST_BOX (box));
+  g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
+  g_return_if_fail (model == NULL || create_widget_func != NULL);
+  g_return_if_fail (model == NULL || bind_row_func != NULL);
 
-  g_signal_connect (priv->bound_model, "items-changed", G_CALLBACK (gtk_list_box_bound_model_changed), box);
-  gtk_list_box_bound_model_changed (model, 0, 0, g_list_model_get_n_items (model), box);
+  gtk_list_box_bind_model_internal (box, model, create_widget_func, bind_row_func, user_data, user_data_free_func);
 }
@@ -176,6 +176,23 @@ typedef void (*GtkListBoxUpdateHeaderFunc) (GtkListBoxRow *row,
 typedef GtkWidget * (*GtkListBoxCreateWidgetFunc) (gpointer item,
                                                    gpointer user_data);
 
+/**
+ * GtkListBoxBindRowFunc:
+ * @row: a row that was previously created for a different item
+ * @item: (type GObject): the item from the model that @row should now represent
+ * @user_data: (closure): user data
+ *
+ * Called for list boxes that are bound to a #GListModel with
+ * gtk_list_box_bind_model_virtual() when a row that was scrolled
+ * out of view is reused for another item.
+ *
+ * If the create function returned a widget that is not a
+ * #GtkListBoxRow, it can be found with gtk_bin_get_child().
+ */
+typedef void (*GtkListBoxBindRowFunc) (GtkListBoxRow *row,
+                                       gpointer       item,
+                                       gpointer       user_data);
+
 GDK_AVAILABLE_IN_ALL
 GType      gtk_list_box_row_get_type      (void) G_GNUC_CONST;
 GDK_AVAILABLE_IN_ALL
@@ -299,6 +316,13 @@ void           gtk_list_box_bind_model                   (GtkListBox
                                                           GtkListBoxCreateWidgetFunc    create_widget_func,
                                                           gpointer                      user_data,
                                                           GDestroyNotify                user_data_free_func);
+GDK_AVAILABLE_IN_ALL
+void           gtk_list_box_bind_model_virtual           (GtkListBox                   *box,
+                                                          GListModel                   *model,
+                                                          GtkListBoxCreateWidgetFunc    create_widget_func,
+                                                          GtkListBoxBindRowFunc         bind_row_func,
+                                                          gpointer                      user_data,
+                                                          GDestroyNotify                user_data_free_func);
 
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GtkListBox, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GtkListBoxRow, g_object_unref)
@@ -192,6 +192,9 @@ struct _GtkListStorePrivate
 
   gpointer default_sort_data;
   gpointer seq;         /* head of the list */
+
+  /* row being filled by gtk_list_store_insert_rows(), not announced yet */
+  gpointer filling_row;
 };
 
 #define GTK_LIST_STORE_IS_SORTED(list) (((GtkListStore*)(list))->priv->sort_column_id != GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID)
@@ -935,6 +938,13 @@ gtk_list_store_set_value (GtkListStore *list_store,
   priv = list_store->priv;
   g_return_if_fail (column >= 0 && column < priv->n_columns);
 
+  /* gtk_list_store_insert_rows() takes care of the row once it is filled */
+  if (iter->user_data == priv->filling_row)
+    {
+      gtk_list_store_real_set_value (list_store, iter, column, value, FALSE);
+      return;
+    }
+
   if (gtk_list_store_real_set_value (list_store, iter, column, value, TRUE))
     {
       GtkTreePath *path;
@@ -1095,6 +1105,10 @@ gtk_list_store_set_valuesv (GtkListStore *list_store,
 				      &maybe_need_sort,
 				      columns, values, n_values);
 
+  /* gtk_list_store_insert_rows() takes care of the row once it is filled */
+  if (iter->user_data == priv->filling_row)
+    return;
+
   if (maybe_need_sort && GTK_LIST_STORE_IS_SORTED (list_store))
     gtk_list_store_sort_iter_changed (list_store, iter, priv->sort_column_id);
 
@@ -1137,6 +1151,10 @@ gtk_list_store_set_valist (GtkListStore *list_store,
 				      &maybe_need_sort,
 				      var_args);
 
+  /* gtk_list_store_insert_rows() takes care of the row once it is filled */
+  if (iter->user_data == priv->filling_row)
+    return;
+
   if (maybe_need_sort && GTK_LIST_STORE_IS_SORTED (list_store))
     gtk_list_store_sort_iter_changed (list_store, iter, priv->sort_column_id);
 
@@ -2307,6 +2325,103 @@ gtk_list_store_insert_with_valuesv (GtkListStore *list_store,
   gtk_tree_path_free (path);
 }
 
+/**
+ * gtk_list_store_insert_rows:
+ * @list_store: A #GtkListStore
+ * @position: position to insert the new rows, or -1 to append them
+ * @n_rows: the number of rows to insert
+ * @fill_func: (scope call) (allow-none): function to set the values
+ *     of each new row, or %NULL to insert empty rows
+ * @user_data: user data to pass to @fill_func
+ *
+ * Inserts @n_rows new rows at @position, calling @fill_func to set
+ * the values of each of them. This is considerably faster than calling
+ * gtk_list_store_insert_with_values() in a loop when loading large
+ * amounts of data.
+ *
+ * Setting values from @fill_func does not emit #GtkTreeModel::row-changed
+ * or cause the row to be resorted. Instead, every row is put in place and
+ * #GtkTreeModel::row-inserted is emitted once after @fill_func returned
+ * for it. @fill_func must not modify @list_store other than by setting
+ * values on the row it is given.
+ *
+ * If the list is sorted, @position is ignored and the rows are inserted
+ * at their sorted positions.
+ *
+ * Views connected to the store still have to handle every inserted row,
+ * so for the fastest possible loading, fill the store before setting it
+ * as the model of a view.
+ */
+void
+gtk_list_store_insert_rows (GtkListStore         *list_store,
+                            gint                  position,
+                            gint                  n_rows,
+                            GtkListStoreFillFunc  fill_func,
+                            gpointer              user_data)
+{
+  GtkListStorePrivate *priv;
+  GtkTreePath *path;
+  GSequenceIter *ptr;
+  GtkTreeIter iter;
+  gboolean sorted;
+  gint length;
+  gint i;
+
+  g_return_if_fail (GTK_IS_LIST_STORE (list_store));
+  g_return_if_fail (n_rows >= 0);
+
+  priv = list_store->priv;
+  g_return_if_fail (priv->filling_row == NULL);
+
+  if (n_rows == 0)
+    return;
+
+  priv->columns_dirty = TRUE;
+  sorted = GTK_LIST_STORE_IS_SORTED (list_store);
+
+  length = g_sequence_get_length (priv->seq);
+  if (position > length || position < 0)
+    position = length;
+
+  /* Rows are inserted before ptr, which stays the same for all of them,
+   * so the path of each row is the one of the previous row plus one.
+   */
+  ptr = g_sequence_get_iter_at_pos (priv->seq, position);
+  path = gtk_tree_path_new_from_indices (position, -1);
+
+  iter.stamp = priv->stamp;
+
+  for (i = 0; i < n_rows; i++)
+    {
+      iter.user_data = g_sequence_insert_before (ptr, NULL);
+      priv->length++;
+
+      if (fill_func)
+        {
+          priv->filling_row = iter.user_data;
+          fill_func (list_store, &iter, i, user_data);
+          priv->filling_row = NULL;
+        }
+
+      if (sorted)
+        {
+          g_sequence_sort_changed_iter (iter.user_data,
+                                        gtk_list_store_compare_func,
+                                        list_store);
+
+          gtk_tree_path_free (path);
+          path = gtk_list_store_get_path (GTK_TREE_MODEL (list_store), &iter);
+        }
+
+      gtk_tree_model_row_inserted (GTK_TREE_MODEL (list_store), path, &iter);
+
+      if (!sorted)
+        gtk_tree_path_next (path);
+    }
+
+  gtk_tree_path_free (path);
+}
+
 /* GtkBuildable custom tag implementation
  *
  * <columns>
@@ -41,6 +41,21 @@ typedef struct _GtkListStore              GtkListStore;
 typedef struct _GtkListStorePrivate       GtkListStorePrivate;
 typedef struct _GtkListStoreClass         GtkListStoreClass;
 
+/**
+ * GtkListStoreFillFunc:
+ * @list_store: the #GtkListStore being filled
+ * @iter: the new row
+ * @index: the index of the row among the rows being inserted
+ * @user_data: (closure): user data passed to gtk_list_store_insert_rows()
+ *
+ * Sets the values of a row inserted with gtk_list_store_insert_rows(),
+ * usually by calling gtk_list_store_set().
+ */
+typedef void (* GtkListStoreFillFunc) (GtkListStore *list_store,
+                                       GtkTreeIter  *iter,
+                                       gint          index,
+                                       gpointer      user_data);
+
 struct _GtkListStore
 {
   GObject parent;
@@ -123,6 +138,12 @@ void          gtk_list_store_insert_with_valuesv (GtkListStore *list_store,
 						  GValue       *values,
 						  gint          n_values);
 GDK_AVAILABLE_IN_ALL
+void          gtk_list_store_insert_rows      (GtkListStore         *list_store,
+                                               gint                  position,
+                                               gint                  n_rows,
+                                               GtkListStoreFillFunc  fill_func,
+                                               gpointer              user_data);
+GDK_AVAILABLE_IN_ALL
 void          gtk_list_store_prepend          (GtkListStore *list_store,
 					       GtkTreeIter  *iter);
 GDK_AVAILABLE_IN_ALL
@@ -115,6 +115,7 @@
 
 #include "gtkaccelmapprivate.h"
 #include "gtkbox.h"
+#include "gtkcssprofilerprivate.h"
 #include "gtkdebug.h"
 #include "gtkdndprivate.h"
 #include "gtkmain.h"
@@ -619,6 +620,8 @@ do_pre_parse_initialization (void)
       slowdown = g_ascii_strtod (env_string, NULL);
       _gtk_set_slowdown (slowdown);
     }
+
+  gtk_css_profiler_init_from_env ();
 }
 
 static void
@@ -24,6 +24,8 @@
 #include "gtkintl.h"
 #include "gtkprivate.h"
 
+#include <string.h>
+
 /**
  * SECTION:gtksortlistmodel
  * @title: GtkSortListModel
@@ -33,6 +35,17 @@
  * #GtkSortListModel is a list model that takes a list model and
  * sorts its elements according to a compare function.
  *
+ * If comparing items is expensive, for example because the values
+ * to compare need to be computed from the item's properties, a
+ * #GtkSortListModelKeyFunc can be set with
+ * gtk_sort_list_model_set_sort_key_func(). It is called once per
+ * item and the resulting keys are compared instead of the items.
+ *
+ * By default, sorting happens synchronously. For large models,
+ * #GtkSortListModel:incremental can be set to sort in small steps
+ * from an idle handler, so that the application stays responsive.
+ * The model keeps its previous order until sorting is done.
+ *
  * #GtkSortListModel is a generic model and because of that it
  * cannot take advantage of any external knowledge when sorting.
  * If you run into performance issues with #GtkSortListModel, it
@@ -43,23 +56,58 @@
 enum {
   PROP_0,
   PROP_HAS_SORT,
+  PROP_INCREMENTAL,
   PROP_ITEM_TYPE,
   PROP_MODEL,
+  PROP_PENDING,
   NUM_PROPERTIES
 };
 
+/* Time in microseconds that incremental sorting may take per idle */
+#define SORT_INCREMENTAL_TIME_SLICE 1000
+
+typedef struct _SortItem SortItem;
+typedef struct _SortKey SortKey;
+
+/* The data in the sorted sequence */
+struct _SortItem {
+  gpointer item;
+  gpointer key; /* the item itself if there is no key func */
+};
+
+/* The array that gets sorted on resorts */
+struct _SortKey {
+  gpointer key;
+  GSequenceIter *iter;
+};
+
 struct _GtkSortListModel
 {
   GObject parent_instance;
 
   GType item_type;
   GListModel *model;
+  GtkSortListModelKeyFunc key_func;
+  GDestroyNotify key_free;
   GCompareDataFunc sort_func;
   gpointer user_data;
   GDestroyNotify user_destroy;
 
   GSequence *sorted; /* NULL if sort_func == NULL */
   GSequence *unsorted; /* NULL if sort_func == NULL */
+
+  gboolean incremental;
+  /* State of a running bottom-up merge sort, sort_keys is NULL if not sorting */
+  SortKey *sort_keys;
+  SortKey *sort_buffer;
+  guint sort_n_items;
+  guint sort_n_passes;
+  guint sort_pass;
+  guint sort_start; /* start of the two runs being merged */
+  guint sort_left;
+  guint sort_right;
+  guint sort_out;
+  guint sort_source_id;
 };
 
 struct _GtkSortListModelClass
@@ -97,6 +145,7 @@ gtk_sort_list_model_get_item (GListModel *list,
 {
   GtkSortListModel *self = GTK_SORT_LIST_MODEL (list);
   GSequenceIter *iter;
+  SortItem *sort_item;
 
   if (self->model == NULL)
     return NULL;
@@ -108,7 +157,9 @@ gtk_sort_list_model_get_item (GListModel *list,
   if (g_sequence_iter_is_end (iter))
       return NULL;
 
-  return g_object_ref (g_sequence_get (iter));
+  sort_item = g_sequence_get (iter);
+
+  return g_object_ref (sort_item->item);
 }
 
 static void
@@ -122,6 +173,313 @@ gtk_sort_list_model_model_init (GListModelInterface *iface)
 G_DEFINE_TYPE_WITH_CODE (GtkSortListModel, gtk_sort_list_model, G_TYPE_OBJECT,
                          G_IMPLEMENT_INTERFACE (G_TYPE_LIST_MODEL, gtk_sort_list_model_model_init))
 
+static void
+gtk_sort_list_model_update_key (GtkSortListModel *self,
+                                SortItem         *sort_item)
+{
+  if (self->key_func)
+    {
+      if (self->key_free && sort_item->key)
+        self->key_free (sort_item->key);
+      sort_item->key = self->key_func (sort_item->item, self->user_data);
+    }
+  else
+    sort_item->key = sort_item->item;
+}
+
+static void
+gtk_sort_list_model_clear_key (GtkSortListModel *self,
+                               SortItem         *sort_item)
+{
+  if (self->key_func && self->key_free && sort_item->key)
+    self->key_free (sort_item->key);
+  sort_item->key = NULL;
+}
+
+static SortItem *
+gtk_sort_list_model_new_item (GtkSortListModel *self,
+                              guint             position)
+{
+  SortItem *sort_item;
+
+  sort_item = g_slice_new0 (SortItem);
+  sort_item->item = g_list_model_get_item (self->model, position);
+  gtk_sort_list_model_update_key (self, sort_item);
+
+  return sort_item;
+}
+
+static void
+gtk_sort_list_model_free_item (GtkSortListModel *self,
+                               SortItem         *sort_item)
+{
+  gtk_sort_list_model_clear_key (self, sort_item);
+  g_object_unref (sort_item->item);
+  g_slice_free (SortItem, sort_item);
+}
+
+static void
+gtk_sort_list_model_foreach_item (GtkSortListModel *self,
+                                  void           (* func) (GtkSortListModel *, SortItem *))
+{
+  GSequenceIter *iter;
+
+  for (iter = g_sequence_get_begin_iter (self->sorted);
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    func (self, g_sequence_get (iter));
+}
+
+static void
+gtk_sort_list_model_clear_sequences (GtkSortListModel *self)
+{
+  if (self->sorted == NULL)
+    return;
+
+  gtk_sort_list_model_foreach_item (self, gtk_sort_list_model_free_item);
+  g_clear_pointer (&self->sorted, g_sequence_free);
+  g_clear_pointer (&self->unsorted, g_sequence_free);
+}
+
+static int
+gtk_sort_list_model_compare_items (gconstpointer a,
+                                   gconstpointer b,
+                                   gpointer      data)
+{
+  GtkSortListModel *self = data;
+  const SortItem *ia = a;
+  const SortItem *ib = b;
+
+  return self->sort_func (ia->key, ib->key, self->user_data);
+}
+
+static guint
+gtk_sort_list_model_get_pending_items (GtkSortListModel *self)
+{
+  guint64 done;
+
+  if (self->sort_keys == NULL)
+    return 0;
+
+  /* An estimate: every pass of the merge sort touches every item once */
+  done = (guint64) self->sort_pass * self->sort_n_items + self->sort_out;
+
+  return self->sort_n_items - done / self->sort_n_passes;
+}
+
+static void
+gtk_sort_list_model_stop_sorting (GtkSortListModel *self)
+{
+  if (self->sort_keys == NULL)
+    return;
+
+  g_clear_pointer (&self->sort_keys, g_free);
+  g_clear_pointer (&self->sort_buffer, g_free);
+  if (self->sort_source_id)
+    {
+      g_source_remove (self->sort_source_id);
+      self->sort_source_id = 0;
+    }
+
+  if (self->incremental)
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+}
+
+/* Moves the merge sort forward until it is done or until @end_time
+ * has passed. Returns %TRUE when the keys are sorted. */
+static gboolean
+gtk_sort_list_model_sort_step (GtkSortListModel *self,
+                               gint64            end_time)
+{
+  SortKey *keys = self->sort_keys;
+  SortKey *buffer = self->sort_buffer;
+  guint n = self->sort_n_items;
+  guint work = 0;
+
+  while (self->sort_pass < self->sort_n_passes)
+    {
+      guint width = 1 << self->sort_pass;
+      guint start = self->sort_start;
+      guint mid = MIN (start + width, n);
+      guint end = MIN (start + 2 * width, n);
+      guint left = self->sort_left;
+      guint right = self->sort_right;
+      guint out = self->sort_out;
+
+      /* Runs that are already in order just get copied */
+      if (out == start &&
+          (mid == end ||
+           self->sort_func (keys[mid - 1].key, keys[mid].key, self->user_data) <= 0))
+        {
+          memcpy (buffer + start, keys + start, (end - start) * sizeof (SortKey));
+          left = mid;
+          right = end;
+          out = end;
+        }
+
+      while (left < mid && right < end)
+        {
+          if (self->sort_func (keys[right].key, keys[left].key, self->user_data) < 0)
+            buffer[out++] = keys[right++];
+          else
+            buffer[out++] = keys[left++];
+
+          if (++work >= 1024 && (work = 0, g_get_monotonic_time () >= end_time))
+            {
+              self->sort_left = left;
+              self->sort_right = right;
+              self->sort_out = out;
+              return FALSE;
+            }
+        }
+
+      if (left < mid)
+        {
+          memcpy (buffer + out, keys + left, (mid - left) * sizeof (SortKey));
+          out += mid - left;
+        }
+      if (right < end)
+        {
+          memcpy (buffer + out, keys + right, (end - right) * sizeof (SortKey));
+          out += end - right;
+        }
+
+      if (end < n)
+        {
+          self->sort_start = end;
+        }
+      else
+        {
+          /* The pass is done, the buffer becomes the input of the next one */
+          self->sort_keys = buffer;
+          self->sort_buffer = keys;
+          keys = self->sort_keys;
+          buffer = self->sort_buffer;
+          self->sort_pass++;
+          self->sort_start = 0;
+        }
+      self->sort_left = self->sort_start;
+      self->sort_right = MIN (self->sort_start + (1 << self->sort_pass), n);
+      self->sort_out = self->sort_start;
+
+      work += end - start;
+      if (work >= 1024)
+        {
+          work = 0;
+          if (g_get_monotonic_time () >= end_time)
+            return self->sort_pass >= self->sort_n_passes;
+        }
+    }
+
+  return TRUE;
+}
+
+/* Puts the sorted sequence in the order computed by the merge sort.
+ * Only the items between the longest unchanged prefix and suffix are
+ * moved and reported as changed. */
+static void
+gtk_sort_list_model_finish_sorting (GtkSortListModel *self,
+                                    gboolean          emit)
+{
+  SortKey *keys = self->sort_keys;
+  GSequenceIter *iter, *anchor;
+  guint i, n, start, end;
+
+  n = self->sort_n_items;
+  self->sort_keys = NULL;
+  g_clear_pointer (&self->sort_buffer, g_free);
+
+  for (iter = g_sequence_get_begin_iter (self->sorted), start = 0;
+       start < n && iter == keys[start].iter;
+       iter = g_sequence_iter_next (iter), start++)
+    ;
+
+  if (start == n)
+    {
+      g_free (keys);
+      return;
+    }
+
+  for (iter = g_sequence_iter_prev (g_sequence_get_end_iter (self->sorted)), end = n;
+       end > start && iter == keys[end - 1].iter;
+       iter = g_sequence_iter_prev (iter), end--)
+    ;
+
+  anchor = end < n ? keys[end].iter : g_sequence_get_end_iter (self->sorted);
+  for (i = start; i < end; i++)
+    g_sequence_move (keys[i].iter, anchor);
+
+  g_free (keys);
+
+  if (emit)
+    g_list_model_items_changed (G_LIST_MODEL (self), start, end - start, end - start);
+}
+
+static gboolean
+gtk_sort_list_model_sort_cb (gpointer data)
+{
+  GtkSortListModel *self = data;
+
+  if (!gtk_sort_list_model_sort_step (self, g_get_monotonic_time () + SORT_INCREMENTAL_TIME_SLICE))
+    {
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+      return G_SOURCE_CONTINUE;
+    }
+
+  self->sort_source_id = 0;
+  gtk_sort_list_model_finish_sorting (self, TRUE);
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Sorts the sorted sequence again, using the keys it contains.
+ * In incremental mode, this only starts the sorting. */
+static void
+gtk_sort_list_model_start_sorting (GtkSortListModel *self,
+                                   gboolean          emit)
+{
+  GSequenceIter *iter;
+  guint i, n;
+
+  gtk_sort_list_model_stop_sorting (self);
+
+  n = g_sequence_get_length (self->sorted);
+  if (n <= 1)
+    return;
+
+  self->sort_keys = g_new (SortKey, n);
+  self->sort_buffer = g_new (SortKey, n);
+  for (iter = g_sequence_get_begin_iter (self->sorted), i = 0;
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter), i++)
+    {
+      SortItem *sort_item = g_sequence_get (iter);
+
+      self->sort_keys[i].key = sort_item->key;
+      self->sort_keys[i].iter = iter;
+    }
+  self->sort_n_items = n;
+  self->sort_n_passes = g_bit_storage (n - 1);
+  self->sort_pass = 0;
+  self->sort_start = 0;
+  self->sort_left = 0;
+  self->sort_right = 1;
+  self->sort_out = 0;
+
+  if (self->incremental)
+    {
+      self->sort_source_id = g_idle_add (gtk_sort_list_model_sort_cb, self);
+      g_source_set_name_by_id (self->sort_source_id, "[gtk] gtk_sort_list_model_sort_cb");
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+    }
+  else
+    {
+      gtk_sort_list_model_sort_step (self, G_MAXINT64);
+      gtk_sort_list_model_finish_sorting (self, emit);
+    }
+}
+
 static void
 gtk_sort_list_model_remove_items (GtkSortListModel *self,
                                   guint             position,
@@ -147,6 +505,7 @@ gtk_sort_list_model_remove_items (GtkSortListModel *self,
       start = MIN (start, pos);
       end = MIN (end, length_before - i - 1 - pos);
 
+      gtk_sort_list_model_free_item (self, g_sequence_get (sorted_iter));
       g_sequence_remove (sorted_iter);
       g_sequence_remove (unsorted_iter);
 
@@ -157,6 +516,81 @@ gtk_sort_list_model_remove_items (GtkSortListModel *self,
   *unmodified_end = end;
 }
 
+typedef struct _SortEntry SortEntry;
+
+struct _SortEntry {
+  SortItem *item;
+  guint position;
+};
+
+static int
+gtk_sort_list_model_compare_entries (gconstpointer a,
+                                     gconstpointer b,
+                                     gpointer      data)
+{
+  const SortEntry *ea = a;
+  const SortEntry *eb = b;
+
+  return gtk_sort_list_model_compare_items (ea->item, eb->item, data);
+}
+
+/* Sorts the new items by themselves and then merges them into the
+ * sorted sequence in a single pass. This needs O(length + n_items)
+ * comparisons instead of O(n_items * log (length)), so it's used when
+ * many items get added at once. */
+static void
+gtk_sort_list_model_merge_items (GtkSortListModel *self,
+                                 guint             position,
+                                 guint             n_items,
+                                 guint            *unmodified_start,
+                                 guint            *unmodified_end)
+{
+  GSequenceIter *unsorted_iter, *sorted_iter;
+  GSequenceIter **iters;
+  SortEntry *entries;
+  guint i, pos, start, length_before;
+
+  length_before = g_sequence_get_length (self->sorted);
+
+  entries = g_new (SortEntry, n_items);
+  for (i = 0; i < n_items; i++)
+    {
+      entries[i].item = gtk_sort_list_model_new_item (self, position + i);
+      entries[i].position = i;
+    }
+  g_qsort_with_data (entries, n_items, sizeof (SortEntry), gtk_sort_list_model_compare_entries, self);
+
+  iters = g_new (GSequenceIter *, n_items);
+  sorted_iter = g_sequence_get_begin_iter (self->sorted);
+  start = pos = 0;
+  for (i = 0; i < n_items; i++)
+    {
+      while (!g_sequence_iter_is_end (sorted_iter) &&
+             gtk_sort_list_model_compare_items (g_sequence_get (sorted_iter), entries[i].item, self) <= 0)
+        {
+          sorted_iter = g_sequence_iter_next (sorted_iter);
+          pos++;
+        }
+
+      iters[entries[i].position] = g_sequence_insert_before (sorted_iter, entries[i].item);
+      if (i == 0)
+        start = pos;
+      pos++;
+    }
+
+  unsorted_iter = g_sequence_get_iter_at_pos (self->unsorted, position);
+  for (i = 0; i < n_items; i++)
+    g_sequence_insert_before (unsorted_iter, iters[i]);
+
+  g_free (iters);
+  g_free (entries);
+
+  if (unmodified_start)
+    *unmodified_start = start;
+  if (unmodified_end)
+    *unmodified_end = length_before + n_items - pos;
+}
+
 static void
 gtk_sort_list_model_add_items (GtkSortListModel *self,
                                guint             position,
@@ -167,13 +601,30 @@ gtk_sort_list_model_add_items (GtkSortListModel *self,
   GSequenceIter *unsorted_iter, *sorted_iter;
   guint i, pos, start, end, length_before;
 
+  length_before = g_sequence_get_length (self->sorted);
+
+  if (n_items == 0)
+    {
+      if (unmodified_start)
+        *unmodified_start = length_before;
+      if (unmodified_end)
+        *unmodified_end = length_before;
+      return;
+    }
+
+  if ((guint64) n_items * g_bit_storage (length_before) > length_before)
+    {
+      gtk_sort_list_model_merge_items (self, position, n_items, unmodified_start, unmodified_end);
+      return;
+    }
+
   unsorted_iter = g_sequence_get_iter_at_pos (self->unsorted, position);
-  start = end = length_before = g_sequence_get_length (self->sorted);
+  start = end = length_before;
 
   for (i = 0; i < n_items; i++)
     {
-      gpointer item = g_list_model_get_item (self->model, position + i);
-      sorted_iter = g_sequence_insert_sorted (self->sorted, item, self->sort_func, self->user_data);
+      SortItem *sort_item = gtk_sort_list_model_new_item (self, position + i);
+      sorted_iter = g_sequence_insert_sorted (self->sorted, sort_item, gtk_sort_list_model_compare_items, self);
       g_sequence_insert_before (unsorted_iter, sorted_iter);
       if (unmodified_start != NULL || unmodified_end != NULL)
         {
@@ -197,6 +648,7 @@ gtk_sort_list_model_items_changed_cb (GListModel       *model,
                                       GtkSortListModel *self)
 {
   guint n_items, start, end, start2, end2;
+  gboolean was_sorting;
 
   if (removed == 0 && added == 0)
     return;
@@ -207,6 +659,10 @@ gtk_sort_list_model_items_changed_cb (GListModel       *model,
       return;
     }
 
+  /* The sort keeps pointers to the items, so it has to start over */
+  was_sorting = self->sort_keys != NULL;
+  gtk_sort_list_model_stop_sorting (self);
+
   gtk_sort_list_model_remove_items (self, position, removed, &start, &end);
   gtk_sort_list_model_add_items (self, position, added, &start2, &end2);
   start = MIN (start, start2);
@@ -214,6 +670,9 @@ gtk_sort_list_model_items_changed_cb (GListModel       *model,
 
   n_items = g_sequence_get_length (self->sorted) - start - end;
   g_list_model_items_changed (G_LIST_MODEL (self), start, n_items - added + removed, n_items);
+
+  if (was_sorting && self->sorted)
+    gtk_sort_list_model_start_sorting (self, TRUE);
 }
 
 static void
@@ -226,6 +685,10 @@ gtk_sort_list_model_set_property (GObject      *object,
 
   switch (prop_id)
     {
+    case PROP_INCREMENTAL:
+      gtk_sort_list_model_set_incremental (self, g_value_get_boolean (value));
+      break;
+
     case PROP_ITEM_TYPE:
       self->item_type = g_value_get_gtype (value);
       break;
@@ -240,7 +703,7 @@ gtk_sort_list_model_set_property (GObject      *object,
     }
 }
 
-static void 
+static void
 gtk_sort_list_model_get_property (GObject     *object,
                                   guint        prop_id,
                                   GValue      *value,
@@ -254,6 +717,10 @@ gtk_sort_list_model_get_property (GObject     *object,
       g_value_set_boolean (value, self->sort_func != NULL);
       break;
 
+    case PROP_INCREMENTAL:
+      g_value_set_boolean (value, self->incremental);
+      break;
+
     case PROP_ITEM_TYPE:
       g_value_set_gtype (value, self->item_type);
       break;
@@ -262,6 +729,10 @@ gtk_sort_list_model_get_property (GObject     *object,
       g_value_set_object (value, self->model);
       break;
 
+    case PROP_PENDING:
+      g_value_set_uint (value, gtk_sort_list_model_get_pending_items (self));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -274,10 +745,10 @@ gtk_sort_list_model_clear_model (GtkSortListModel *self)
   if (self->model == NULL)
     return;
 
+  gtk_sort_list_model_stop_sorting (self);
   g_signal_handlers_disconnect_by_func (self->model, gtk_sort_list_model_items_changed_cb, self);
+  gtk_sort_list_model_clear_sequences (self);
   g_clear_object (&self->model);
-  g_clear_pointer (&self->sorted, g_sequence_free);
-  g_clear_pointer (&self->unsorted, g_sequence_free);
 }
 
 static void
@@ -288,6 +759,8 @@ gtk_sort_list_model_dispose (GObject *object)
   gtk_sort_list_model_clear_model (self);
   if (self->user_destroy)
     self->user_destroy (self->user_data);
+  self->key_func = NULL;
+  self->key_free = NULL;
   self->sort_func = NULL;
   self->user_data = NULL;
   self->user_destroy = NULL;
@@ -316,6 +789,18 @@ gtk_sort_list_model_class_init (GtkSortListModelClass *class)
                             FALSE,
                             GTK_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * GtkSortListModel:incremental:
+   *
+   * If the model should sort items incrementally
+   */
+  properties[PROP_INCREMENTAL] =
+      g_param_spec_boolean ("incremental",
+                            P_("Incremental"),
+                            P_("Sort items incrementally"),
+                            FALSE,
+                            GTK_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+
   /**
    * GtkSortListModel:item-type:
    *
@@ -340,6 +825,18 @@ gtk_sort_list_model_class_init (GtkSortListModelClass *class)
                            G_TYPE_LIST_MODEL,
                            GTK_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * GtkSortListModel:pending:
+   *
+   * Estimate of the number of items not yet sorted
+   */
+  properties[PROP_PENDING] =
+      g_param_spec_uint ("pending",
+                         P_("Pending"),
+                         P_("Estimate of the number of items not yet sorted"),
+                         0, G_MAXUINT, 0,
+                         GTK_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 }
 
@@ -401,16 +898,80 @@ gtk_sort_list_model_new_for_type (GType item_type)
                        NULL);
 }
 
+/* Creates the sequences with the items in the order of the model,
+ * they need to be sorted afterwards. */
 static void
 gtk_sort_list_model_create_sequences (GtkSortListModel *self)
 {
+  guint i, n_items;
+
   if (!self->sort_func || self->model == NULL)
     return;
 
-  self->sorted = g_sequence_new (g_object_unref);
+  self->sorted = g_sequence_new (NULL);
   self->unsorted = g_sequence_new (NULL);
 
-  gtk_sort_list_model_add_items (self, 0, g_list_model_get_n_items (self->model), NULL, NULL);
+  n_items = g_list_model_get_n_items (self->model);
+  for (i = 0; i < n_items; i++)
+    {
+      GSequenceIter *sorted_iter;
+
+      sorted_iter = g_sequence_append (self->sorted, gtk_sort_list_model_new_item (self, i));
+      g_sequence_append (self->unsorted, sorted_iter);
+    }
+}
+
+static void
+gtk_sort_list_model_set_sort (GtkSortListModel        *self,
+                              GtkSortListModelKeyFunc  key_func,
+                              GDestroyNotify           key_free,
+                              GCompareDataFunc         sort_func,
+                              gpointer                 user_data,
+                              GDestroyNotify           user_destroy)
+{
+  gboolean had_sort;
+  guint n_items;
+
+  had_sort = self->sort_func != NULL;
+  if (!sort_func && !had_sort)
+    return;
+
+  gtk_sort_list_model_stop_sorting (self);
+
+  /* Keys need to be freed by the old key_free function */
+  if (self->sorted)
+    gtk_sort_list_model_foreach_item (self, gtk_sort_list_model_clear_key);
+
+  if (self->user_destroy)
+    self->user_destroy (self->user_data);
+
+  self->key_func = key_func;
+  self->key_free = key_free;
+  self->sort_func = sort_func;
+  self->user_data = user_data;
+  self->user_destroy = user_destroy;
+
+  if (sort_func == NULL)
+    {
+      gtk_sort_list_model_clear_sequences (self);
+
+      n_items = g_list_model_get_n_items (G_LIST_MODEL (self));
+      if (n_items > 1)
+        g_list_model_items_changed (G_LIST_MODEL (self), 0, n_items, n_items);
+    }
+  else if (self->model)
+    {
+      /* Either way, the sequences are in the order that is currently
+       * visible, so sorting them reports exactly what changed. */
+      if (self->sorted)
+        gtk_sort_list_model_foreach_item (self, gtk_sort_list_model_update_key);
+      else
+        gtk_sort_list_model_create_sequences (self);
+
+      gtk_sort_list_model_start_sorting (self, TRUE);
+    }
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_HAS_SORT]);
 }
 
 /**
@@ -431,30 +992,44 @@ gtk_sort_list_model_set_sort_func (GtkSortListModel *self,
                                    gpointer          user_data,
                                    GDestroyNotify    user_destroy)
 {
-  guint n_items;
-
   g_return_if_fail (GTK_IS_SORT_LIST_MODEL (self));
   g_return_if_fail (sort_func != NULL || (user_data == NULL && !user_destroy));
 
-  if (!sort_func && !self->sort_func)
-    return;
-
-  if (self->user_destroy)
-    self->user_destroy (self->user_data);
+  gtk_sort_list_model_set_sort (self, NULL, NULL, sort_func, user_data, user_destroy);
+}
 
-  g_clear_pointer (&self->unsorted, g_sequence_free);
-  g_clear_pointer (&self->sorted, g_sequence_free);
-  self->sort_func = sort_func;
-  self->user_data = user_data;
-  self->user_destroy = user_destroy;
-  
-    gtk_sort_list_model_create_sequences (self);
-    
-  n_items = g_list_model_get_n_items (G_LIST_MODEL (self));
-  if (n_items > 1)
-    g_list_model_items_changed (G_LIST_MODEL (self), 0, n_items, n_items);
+/**
+ * gtk_sort_list_model_set_sort_key_func:
+ * @self: a #GtkSortListModel
+ * @key_func: function to compute the sort key of an item
+ * @key_free: (allow-none): function to free the keys returned by @key_func
+ * @key_compare: function to compare two keys
+ * @user_data: user data passed to @key_func and @key_compare
+ * @user_destroy: destroy notifier for @user_data
+ *
+ * Sets the model to sort items by keys.
+ *
+ * @key_func is called once for every item to compute its key. The
+ * keys are kept until the item is removed or the model is resorted.
+ * The items are sorted by comparing their keys with @key_compare.
+ *
+ * This is faster than gtk_sort_list_model_set_sort_func() if the
+ * values to compare are expensive to get from the items, because
+ * every item gets looked at only once instead of once per comparison.
+ **/
+void
+gtk_sort_list_model_set_sort_key_func (GtkSortListModel        *self,
+                                       GtkSortListModelKeyFunc  key_func,
+                                       GDestroyNotify           key_free,
+                                       GCompareDataFunc         key_compare,
+                                       gpointer                 user_data,
+                                       GDestroyNotify           user_destroy)
+{
+  g_return_if_fail (GTK_IS_SORT_LIST_MODEL (self));
+  g_return_if_fail (key_func != NULL);
+  g_return_if_fail (key_compare != NULL);
 
-  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_HAS_SORT]);
+  gtk_sort_list_model_set_sort (self, key_func, key_free, key_compare, user_data, user_destroy);
 }
 
 /**
@@ -491,10 +1066,12 @@ gtk_sort_list_model_set_model (GtkSortListModel *self,
       added = g_list_model_get_n_items (model);
 
       gtk_sort_list_model_create_sequences (self);
+      if (self->sorted)
+        gtk_sort_list_model_start_sorting (self, FALSE);
     }
   else
     added = 0;
-  
+
   if (removed > 0 || added > 0)
     g_list_model_items_changed (G_LIST_MODEL (self), 0, removed, added);
 
@@ -540,24 +1117,104 @@ gtk_sort_list_model_has_sort (GtkSortListModel *self)
  * Causes @self to resort all items in the model.
  *
  * Calling this function is necessary when data used by the sort
- * function has changed.
+ * function has changed. If a key function is set, the keys of all
+ * items are computed again.
+ *
+ * Only the range of items that actually changed position is reported
+ * in the #GListModel::items-changed signal.
  **/
 void
 gtk_sort_list_model_resort (GtkSortListModel *self)
 {
-  guint n_items;
-
   g_return_if_fail (GTK_IS_SORT_LIST_MODEL (self));
-  
+
   if (self->sorted == NULL)
     return;
 
-  n_items = g_list_model_get_n_items (self->model);
-  if (n_items <= 1)
+  gtk_sort_list_model_stop_sorting (self);
+
+  if (self->key_func)
+    gtk_sort_list_model_foreach_item (self, gtk_sort_list_model_update_key);
+
+  gtk_sort_list_model_start_sorting (self, TRUE);
+}
+
+/**
+ * gtk_sort_list_model_set_incremental:
+ * @self: a #GtkSortListModel
+ * @incremental: %TRUE to sort incrementally
+ *
+ * Sets the sort model to do an incremental sort.
+ *
+ * When sorting incrementally, the items are not sorted all at once
+ * when the sort function changes or gtk_sort_list_model_resort() is
+ * called. Instead, the sorting is done in small steps from an idle
+ * handler and the model keeps its previous order until it is done.
+ * Then #GListModel::items-changed is emitted once for the items that
+ * changed their position.
+ *
+ * Changes to the model while a sorting is in progress make it start
+ * over.
+ *
+ * Use gtk_sort_list_model_get_pending() to find out about the
+ * progress.
+ **/
+void
+gtk_sort_list_model_set_incremental (GtkSortListModel *self,
+                                     gboolean          incremental)
+{
+  g_return_if_fail (GTK_IS_SORT_LIST_MODEL (self));
+
+  if (self->incremental == incremental)
     return;
 
-  g_sequence_sort (self->sorted, self->sort_func, self->user_data);
+  self->incremental = incremental;
+
+  if (!incremental && self->sort_keys)
+    {
+      g_source_remove (self->sort_source_id);
+      self->sort_source_id = 0;
+      gtk_sort_list_model_sort_step (self, G_MAXINT64);
+      gtk_sort_list_model_finish_sorting (self, TRUE);
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PENDING]);
+    }
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_INCREMENTAL]);
+}
+
+/**
+ * gtk_sort_list_model_get_incremental:
+ * @self: a #GtkSortListModel
+ *
+ * Returns whether incremental sorting was enabled via
+ * gtk_sort_list_model_set_incremental().
+ *
+ * Returns: %TRUE if incremental sorting is enabled
+ **/
+gboolean
+gtk_sort_list_model_get_incremental (GtkSortListModel *self)
+{
+  g_return_val_if_fail (GTK_IS_SORT_LIST_MODEL (self), FALSE);
 
-  g_list_model_items_changed (G_LIST_MODEL (self), 0, n_items, n_items);
+  return self->incremental;
 }
 
+/**
+ * gtk_sort_list_model_get_pending:
+ * @self: a #GtkSortListModel
+ *
+ * Returns an estimate of the number of items that still need to be
+ * sorted.
+ *
+ * This is always 0 unless the model is incremental. Otherwise it
+ * goes down from the number of items in the model to 0 while sorting.
+ *
+ * Returns: the estimated number of items not yet sorted
+ **/
+guint
+gtk_sort_list_model_get_pending (GtkSortListModel *self)
+{
+  g_return_val_if_fail (GTK_IS_SORT_LIST_MODEL (self), 0);
+
+  return gtk_sort_list_model_get_pending_items (self);
+}
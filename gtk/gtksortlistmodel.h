@@ -36,6 +36,19 @@ G_BEGIN_DECLS
 GDK_AVAILABLE_IN_ALL
 G_DECLARE_FINAL_TYPE (GtkSortListModel, gtk_sort_list_model, GTK, SORT_LIST_MODEL, GObject)
 
+/**
+ * GtkSortListModelKeyFunc:
+ * @item: (type GObject): The item to compute the key for
+ * @user_data: user data
+ *
+ * User function that is called to compute the sort key of an @item.
+ * The keys of two items are compared to determine their order, so
+ * they should contain everything needed for that.
+ *
+ * Returns: (transfer full): the key for @item
+ */
+typedef gpointer (* GtkSortListModelKeyFunc) (gpointer item, gpointer user_data);
+
 GDK_AVAILABLE_IN_ALL
 GtkSortListModel *      gtk_sort_list_model_new                 (GListModel             *model,
                                                                  GCompareDataFunc        sort_func,
@@ -50,6 +63,13 @@ void                    gtk_sort_list_model_set_sort_func       (GtkSortListMode
                                                                  gpointer                user_data,
                                                                  GDestroyNotify          user_destroy);
 GDK_AVAILABLE_IN_ALL
+void                    gtk_sort_list_model_set_sort_key_func   (GtkSortListModel       *self,
+                                                                 GtkSortListModelKeyFunc key_func,
+                                                                 GDestroyNotify          key_free,
+                                                                 GCompareDataFunc        key_compare,
+                                                                 gpointer                user_data,
+                                                                 GDestroyNotify          user_destroy);
+GDK_AVAILABLE_IN_ALL
 gboolean                gtk_sort_list_model_has_sort            (GtkSortListModel       *self);
 GDK_AVAILABLE_IN_ALL
 void                    gtk_sort_list_model_set_model           (GtkSortListModel       *self,
@@ -60,6 +80,14 @@ GListModel *            gtk_sort_list_model_get_model           (GtkSortListMode
 GDK_AVAILABLE_IN_ALL
 void                    gtk_sort_list_model_resort              (GtkSortListModel       *self);
 
+GDK_AVAILABLE_IN_ALL
+void                    gtk_sort_list_model_set_incremental     (GtkSortListModel       *self,
+                                                                 gboolean                incremental);
+GDK_AVAILABLE_IN_ALL
+gboolean                gtk_sort_list_model_get_incremental     (GtkSortListModel       *self);
+GDK_AVAILABLE_IN_ALL
+guint                   gtk_sort_list_model_get_pending         (GtkSortListModel       *self);
+
 G_END_DECLS
 
 #endif /* __GTK_SORT_LIST_MODEL_H__ */
@@ -123,6 +123,66 @@ gtk_style_provider_changed (GtkStyleProvider *provider)
   g_signal_emit (provider, signals[CHANGED], 0);
 }
 
+/* The filter of the change that is currently being emitted */
+static GtkStyleProviderChangeFilter change_filter = NULL;
+static gpointer change_filter_data = NULL;
+
+/**
+ * gtk_style_provider_changed_filtered:
+ * @provider: the provider that changed
+ * @filter: function deciding which nodes may be affected by the change
+ * @data: data passed to @filter
+ *
+ * Like gtk_style_provider_changed(), but lets the handlers of the
+ * change query gtk_style_provider_change_may_affect() to only
+ * invalidate the nodes that can be affected by the change.
+ **/
+void
+gtk_style_provider_changed_filtered (GtkStyleProvider             *provider,
+                                     GtkStyleProviderChangeFilter  filter,
+                                     gpointer                      data)
+{
+  GtkStyleProviderChangeFilter old_filter;
+  gpointer old_data;
+
+  gtk_internal_return_if_fail (GTK_IS_STYLE_PROVIDER (provider));
+  gtk_internal_return_if_fail (filter != NULL);
+
+  old_filter = change_filter;
+  old_data = change_filter_data;
+  change_filter = filter;
+  change_filter_data = data;
+
+  g_signal_emit (provider, signals[CHANGED], 0);
+
+  change_filter = old_filter;
+  change_filter_data = old_data;
+}
+
+gboolean
+gtk_style_provider_change_is_filtered (void)
+{
+  return change_filter != NULL;
+}
+
+/**
+ * gtk_style_provider_change_may_affect:
+ * @matcher: matcher for the node to check
+ *
+ * Checks if the change that is currently being emitted may
+ * affect the style of nodes matching @matcher.
+ *
+ * Returns: %FALSE if the node does not need to be invalidated
+ **/
+gboolean
+gtk_style_provider_change_may_affect (const GtkCssMatcher *matcher)
+{
+  if (change_filter == NULL)
+    return TRUE;
+
+  return change_filter (matcher, change_filter_data);
+}
+
 GtkSettings *
 gtk_style_provider_get_settings (GtkStyleProvider *provider)
 {
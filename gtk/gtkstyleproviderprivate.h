@@ -31,6 +31,9 @@ G_BEGIN_DECLS
 
 typedef struct _GtkStyleProviderInterface GtkStyleProviderInterface;
 
+typedef gboolean (* GtkStyleProviderChangeFilter) (const GtkCssMatcher *matcher,
+                                                   gpointer             data);
+
 struct _GtkStyleProviderInterface
 {
   GTypeInterface g_iface;
@@ -64,6 +67,11 @@ void                    gtk_style_provider_lookup                (GtkStyleProvid
                                                                   GtkCssChange            *out_change);
 
 void                    gtk_style_provider_changed               (GtkStyleProvider *provider);
+void                    gtk_style_provider_changed_filtered      (GtkStyleProvider *provider,
+                                                                  GtkStyleProviderChangeFilter filter,
+                                                                  gpointer                 data);
+gboolean                gtk_style_provider_change_is_filtered    (void);
+gboolean                gtk_style_provider_change_may_affect     (const GtkCssMatcher     *matcher);
 
 void                    gtk_style_provider_emit_error            (GtkStyleProvider *provider,
                                                                   GtkCssSection           *section,
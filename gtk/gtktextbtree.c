@@ -289,8 +289,6 @@ static void                  gtk_text_btree_node_invalidate_upward    (GtkTextBT
                                                                        gpointer          view_id);
 static NodeData *            gtk_text_btree_node_check_valid          (GtkTextBTreeNode *node,
                                                                        gpointer          view_id);
-static NodeData *            gtk_text_btree_node_check_valid_downward (GtkTextBTreeNode *node,
-                                                                       gpointer          view_id);
 static void                  gtk_text_btree_node_check_valid_upward   (GtkTextBTreeNode *node,
                                                                        gpointer          view_id);
 
@@ -307,8 +305,6 @@ static void                  gtk_text_btree_node_get_size            (GtkTextBTr
                                                                       gpointer          view_id,
                                                                       gint             *width,
                                                                       gint             *height);
-static GtkTextBTreeNode *    gtk_text_btree_node_common_parent       (GtkTextBTreeNode *node1,
-                                                                      GtkTextBTreeNode *node2);
 static void get_tree_bounds       (GtkTextBTree     *tree,
                                    GtkTextIter      *start,
                                    GtkTextIter      *end);
@@ -940,7 +936,6 @@ _gtk_text_btree_delete (GtkTextIter *start,
   if (start_line != end_line)
     {
       BTreeView *view;
-      GtkTextBTreeNode *ancestor_node;
       GtkTextLine *prevline;
       int chars_moved;      
 
@@ -990,7 +985,6 @@ _gtk_text_btree_delete (GtkTextIter *start,
        * width for the deleted lines to the start line, so that when revalidation
        * occurs, the correct change in size is seen.
        */
-      ancestor_node = gtk_text_btree_node_common_parent (curnode, start_line->parent);
       view = tree->views;
       while (view)
         {
@@ -1037,9 +1031,13 @@ _gtk_text_btree_delete (GtkTextIter *start,
               ld->valid = FALSE;
             }
 
-          gtk_text_btree_node_check_valid_downward (ancestor_node, view->view_id);
-          if (ancestor_node->parent)
-            gtk_text_btree_node_check_valid_upward (ancestor_node->parent, view->view_id);
+          /* Nodes that lie completely inside the deleted range have been
+           * freed above, so only the ancestors of the start and end lines
+           * changed. Recomputing just those keeps deleting many lines from
+           * the start of a big buffer from walking the whole tree.
+           */
+          gtk_text_btree_node_check_valid_upward (curnode, view->view_id);
+          gtk_text_btree_node_check_valid_upward (start_line->parent, view->view_id);
 
           view = view->next;
         }
@@ -1176,7 +1174,14 @@ _gtk_text_btree_insert (GtkTextIter *iter,
       
       chunk_len = eol - sol;
 
-      g_assert (g_utf8_validate (&text[sol], chunk_len, NULL));
+      /* The text has been validated by GtkTextBuffer already, doing it
+       * again for every paragraph is a noticeable part of loading big
+       * files, so only do it when debugging.
+       */
+#ifdef G_ENABLE_DEBUG
+      if (GTK_DEBUG_CHECK (TEXT))
+        g_assert (g_utf8_validate (&text[sol], chunk_len, NULL));
+#endif
       seg = _gtk_char_segment_new (&text[sol], chunk_len);
 
       char_count_delta += seg->char_count;
@@ -5387,40 +5392,6 @@ gtk_text_btree_node_check_valid_upward (GtkTextBTreeNode *node,
     }
 }
 
-static NodeData *
-gtk_text_btree_node_check_valid_downward (GtkTextBTreeNode *node,
-                                          gpointer          view_id)
-{
-  if (node->level == 0)
-    {
-      return gtk_text_btree_node_check_valid (node, view_id);
-    }
-  else
-    {
-      GtkTextBTreeNode *child = node->children.node;
-
-      NodeData *nd = gtk_text_btree_node_ensure_data (node, view_id);
-
-      nd->valid = TRUE;
-      nd->width = 0;
-      nd->height = 0;
-
-      while (child)
-        {
-          NodeData *child_nd = gtk_text_btree_node_check_valid_downward (child, view_id);
-
-          if (!child_nd->valid)
-            nd->valid = FALSE;
-          nd->width = MAX (child_nd->width, nd->width);
-          nd->height += child_nd->height;
-
-          child = child->next;
-        }
-      return nd;
-    }
-}
-
-
 
 /**
  * _gtk_text_btree_validate_line:
@@ -5616,28 +5587,6 @@ gtk_text_btree_node_get_size (GtkTextBTreeNode *node, gpointer view_id,
     *height = nd->height;
 }
 
-/* Find the closest common ancestor of the two nodes. FIXME: The interface
- * here isn’t quite right, since for a lot of operations we want to
- * know which children of the common parent correspond to the two nodes
- * (e.g., when computing the order of two iters)
- */
-static GtkTextBTreeNode *
-gtk_text_btree_node_common_parent (GtkTextBTreeNode *node1,
-                                   GtkTextBTreeNode *node2)
-{
-  while (node1->level < node2->level)
-    node1 = node1->parent;
-  while (node2->level < node1->level)
-    node2 = node2->parent;
-  while (node1 != node2)
-    {
-      node1 = node1->parent;
-      node2 = node2->parent;
-    }
-
-  return node1;
-}
-
 /*
  * BTree
  */
@@ -67,6 +67,8 @@ struct _GtkTextBufferPrivate
   /* Whether the buffer has been modified since last save */
   guint modified : 1;
   guint has_selection : 1;
+  /* The selection changed during a user action */
+  guint selection_clipboards_pending : 1;
 };
 
 typedef struct _ClipboardRequest ClipboardRequest;
@@ -3554,6 +3556,15 @@ update_selection_clipboards (GtkTextBuffer *buffer)
 
   priv = buffer->priv;
 
+  /* Telling the clipboards once at the end of a user action is enough */
+  if (priv->user_action_count > 0)
+    {
+      priv->selection_clipboards_pending = TRUE;
+      return;
+    }
+
+  priv->selection_clipboards_pending = FALSE;
+
   if (gtk_text_buffer_get_selection_bounds (buffer, &start, &end))
     {
       if (priv->selection_content)
@@ -4000,6 +4011,11 @@ gtk_text_buffer_get_selection_bounds (GtkTextBuffer *buffer,
  * user action around the buffer operations they perform, so there's
  * no need to add extra calls if you user action consists solely of a
  * single call to one of those functions.
+ *
+ * Property notifications and updates of the primary selection are
+ * held back until the outermost user action ends, so wrapping many
+ * programmatic edits, like a replace-all, in a user action makes them
+ * cheaper.
  **/
 void
 gtk_text_buffer_begin_user_action (GtkTextBuffer *buffer)
@@ -4010,6 +4026,8 @@ gtk_text_buffer_begin_user_action (GtkTextBuffer *buffer)
   
   if (buffer->priv->user_action_count == 1)
     {
+      g_object_freeze_notify (G_OBJECT (buffer));
+
       /* Outermost nested user action begin emits the signal */
       g_signal_emit (buffer, signals[BEGIN_USER_ACTION], 0);
     }
@@ -4032,6 +4050,11 @@ gtk_text_buffer_end_user_action (GtkTextBuffer *buffer)
   
   if (buffer->priv->user_action_count == 0)
     {
+      if (buffer->priv->selection_clipboards_pending)
+        update_selection_clipboards (buffer);
+
+      g_object_thaw_notify (G_OBJECT (buffer));
+
       /* Ended the outermost-nested user action end, so emit the signal */
       g_signal_emit (buffer, signals[END_USER_ACTION], 0);
     }
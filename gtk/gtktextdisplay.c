@@ -811,6 +811,49 @@ get_text_renderer (void)
   return text_renderer;
 }
 
+/* Finds the part of a line that needs to be drawn for @clip, in
+ * coordinates relative to the top of the line. Glyphs can reach out of
+ * the line into the lines around it, so that includes the ink of the
+ * layout, but only as far as it is visible: a long paragraph can be
+ * taller than any surface the renderer can allocate.
+ */
+static gboolean
+get_line_area (GtkTextLineDisplay *line_display,
+               const GdkRectangle *clip,
+               int                 line_y,
+               GdkRectangle       *area)
+{
+  PangoRectangle ink_rect;
+  int top, bottom;
+
+  pango_layout_get_pixel_extents (line_display->layout, &ink_rect, NULL);
+  top = MIN (0, line_display->top_margin + ink_rect.y);
+  bottom = MAX (line_display->height, line_display->top_margin + ink_rect.y + ink_rect.height);
+
+  top = MAX (top, clip->y - line_y);
+  bottom = MIN (bottom, clip->y + clip->height - line_y);
+
+  area->x = clip->x;
+  area->y = top;
+  area->width = clip->width;
+  area->height = bottom - top;
+
+  return area->height > 0;
+}
+
+/* Renders the text of a line, with its origin at the top of the line */
+static GskRenderNode *
+render_line_node (GtkTextRenderer    *text_renderer,
+                  GtkWidget          *widget,
+                  GtkTextLineDisplay *line_display,
+                  const GdkRectangle *area,
+                  int                 selection_start_index,
+                  int                 selection_end_index)
+{
+  GskRenderNode *node;
+  cairo_t *cr;
+
+  node = gsk_cairo_node_new (&GRAPHENE_RECT_INIT (area->x, area->y, area->width, area->height));
 void
 gtk_text_layout_snapshot (GtkTextLayout      *layout,
                           GtkWidget          *widget,
@@ -818,13 +861,13 @@ gtk_text_layout_snapshot (GtkTextLayout      *layout,
                           const GdkRectangle *clip)
 {
   GtkStyleContext *context;
+  GtkStateFlags state;
   gint offset_y;
   GtkTextRenderer *text_renderer;
   GtkTextIter selection_start, selection_end;
   gboolean have_selection;
   GSList *line_list;
   GSList *tmp_list;
-  cairo_t *cr;
 
   g_return_if_fail (GTK_IS_TEXT_LAYOUT (layout));
   g_return_if_fail (layout->default_style != NULL);
@@ -832,19 +875,16 @@ gtk_text_layout_snapshot (GtkTextLayout      *layout,
   g_return_if_fail (snapshot != NULL);
 
   context = gtk_widget_get_style_context (widget);
+  state = gtk_widget_get_state_flags (widget);
 
   line_list = gtk_text_layout_get_lines (layout, clip->y, clip->y + clip->height, &offset_y);
 
   if (line_list == NULL)
     return; /* nothing on the screen */
 
-  cr = gtk_snapshot_append_cairo (snapshot,
-                                  &GRAPHENE_RECT_INIT(clip->x, clip->y, clip->width, clip->height));
-  text_renderer = get_text_renderer ();
-  text_renderer_begin (text_renderer, widget, cr);
+  gtk_text_layout_set_n_visible_lines (layout, g_slist_length (line_list));
 
-  /* text_renderer_begin/end does cairo_save/restore */
-  cairo_translate (cr, 0, offset_y);
+  text_renderer = get_text_renderer ();
 
   gtk_text_layout_wrap_loop_start (layout);
 
@@ -856,6 +896,7 @@ gtk_text_layout_snapshot (GtkTextLayout      *layout,
   while (tmp_list != NULL)
     {
       GtkTextLineDisplay *line_display;
+      GdkRectangle area;
       gint selection_start_index = -1;
       gint selection_end_index = -1;
 
@@ -863,7 +904,8 @@ gtk_text_layout_snapshot (GtkTextLayout      *layout,
 
       line_display = gtk_text_layout_get_line_display (layout, line, FALSE);
 
-      if (line_display->height > 0)
+      if (line_display->height > 0 &&
+          get_line_area (line_display, clip, offset_y, &area))
         {
           g_assert (line_display->layout != NULL);
           
@@ -895,16 +937,51 @@ gtk_text_layout_snapshot (GtkTextLayout      *layout,
                 }
             }
 
-          render_para (text_renderer, line_display,
-                       selection_start_index, selection_end_index);
+          /* Lines that are drawn the same way as last time reuse
+           * their render node instead of rendering the text again.
+           * The block cursor is part of the node, other cursors are
+           * drawn on top, so blinking them leaves the node alone.
+           * Lines that are only partly visible get a new node when
+           * scrolling shows a different part of them.
+           */
+          if (line_display->node == NULL ||
+              !gdk_rectangle_equal (&line_display->node_area, &area) ||
+              line_display->node_selection_start != selection_start_index ||
+              line_display->node_selection_end != selection_end_index ||
+              line_display->node_state != state ||
+              line_display->node_has_block_cursor != line_display->has_block_cursor ||
+              (line_display->has_block_cursor &&
+               (line_display->node_insert_index != line_display->insert_index ||
+                !gdk_rectangle_equal (&line_display->node_block_cursor, &line_display->block_cursor))))
+            {
+              g_clear_pointer (&line_display->node, gsk_render_node_unref);
+
+              line_display->node = render_line_node (text_renderer, widget, line_display, &area,
+                                                     selection_start_index, selection_end_index);
+              line_display->node_area = area;
+              line_display->node_selection_start = selection_start_index;
+              line_display->node_selection_end = selection_end_index;
+              line_display->node_state = state;
+              line_display->node_has_block_cursor = line_display->has_block_cursor;
+              line_display->node_block_cursor = line_display->block_cursor;
+              line_display->node_insert_index = line_display->insert_index;
+            }
+
+          gtk_snapshot_offset (snapshot, 0, offset_y);
+          gtk_snapshot_append_node (snapshot, line_display->node);
 
           /* We paint the cursors last, because they overlap another chunk
            * and need to appear on top.
            */
           if (line_display->cursors != NULL)
             {
+              cairo_t *cr;
               int i;
 
+              cr = gtk_snapshot_append_cairo (snapshot,
+                                              &GRAPHENE_RECT_INIT (area.x, area.y, area.width, area.height));
+              text_renderer_begin (text_renderer, widget, cr);
+
               for (i = 0; i < line_display->cursors->len; i++)
                 {
                   int index;
@@ -916,19 +993,21 @@ gtk_text_layout_snapshot (GtkTextLayout      *layout,
                                                line_display->x_offset, line_display->top_margin,
                                                line_display->layout, index, dir);
                 }
+
+              text_renderer_end (text_renderer);
+              cairo_destroy (cr);
             }
+
+          gtk_snapshot_offset (snapshot, 0, - offset_y);
         } /* line_display->height > 0 */
 
-      cairo_translate (cr, 0, line_display->height);
+      offset_y += line_display->height;
       gtk_text_layout_free_line_display (layout, line_display);
       
       tmp_list = tmp_list->next;
     }
 
   gtk_text_layout_wrap_loop_end (layout);
-  text_renderer_end (text_renderer);
 
   g_slist_free (line_list);
-
-  cairo_destroy (cr);
 }
@@ -4839,6 +4839,94 @@ strbreakup (const char *string,
   return str_array;
 }
 
+/* Returns %FALSE if none of the character segments of the line
+ * @iter is on contain @byte.
+ */
+static gboolean
+line_contains_byte (const GtkTextIter *iter,
+                    guchar             byte)
+{
+  GtkTextLine *line;
+  GtkTextLineSegment *seg;
+
+  line = _gtk_text_iter_get_text_line (iter);
+
+  for (seg = line->segments; seg != NULL; seg = seg->next)
+    {
+      if (seg->type == &gtk_text_char_type &&
+          memchr (seg->body.chars, byte, seg->byte_count) != NULL)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+static gboolean
+forward_search_lines (const GtkTextIter *iter,
+                      const gchar      **lines,
+                      gboolean           visible_only,
+                      gboolean           slice,
+                      gboolean           case_insensitive,
+                      GtkTextIter       *match_start,
+                      GtkTextIter       *match_end,
+                      const GtkTextIter *limit)
+{
+  GtkTextIter match;
+  GtkTextIter search;
+  gboolean skip_lines;
+
+  /* A match has to contain the first byte of the search string, so
+   * lines that don't can be skipped without extracting their text.
+   * This doesn't work if the text gets case-folded before comparing,
+   * or for the replacement character that slices use for paintables
+   * and child widgets.
+   */
+  skip_lines = !case_insensitive &&
+               lines[0] != NULL &&
+               lines[0][0] != '\0' &&
+               (!slice || lines[0][0] != _gtk_text_unknown_char_utf8[0]);
+
+  search = *iter;
+
+  do
+    {
+      /* This loop has an inefficient worst-case, where
+       * gtk_text_iter_get_text() is called repeatedly on
+       * a single line.
+       */
+      GtkTextIter end;
+
+      if (limit &&
+          gtk_text_iter_compare (&search, limit) >= 0)
+        break;
+
+      if (skip_lines && !line_contains_byte (&search, lines[0][0]))
+        continue;
+      
+      if (lines_match (&search, lines,
+                       visible_only, slice, case_insensitive, &match, &end))
+        {
+          if (limit == NULL ||
+              (limit &&
+               gtk_text_iter_compare (&end, limit) <= 0))
+            {
+              if (match_start)
+                *match_start = match;
+              
+              if (match_end)
+                *match_end = end;
+
+              return TRUE;
+            }
+          
+          break;
+        }
+    }
+  while (gtk_text_iter_forward_line (&search));
+
+  return FALSE;
+}
+
 /**
  * gtk_text_iter_forward_search:
  * @iter: start of search
@@ -4870,8 +4958,7 @@ gtk_text_iter_forward_search (const GtkTextIter *iter,
 {
   gchar **lines = NULL;
   GtkTextIter match;
-  gboolean retval = FALSE;
-  GtkTextIter search;
+  gboolean retval;
   gboolean visible_only;
   gboolean slice;
   gboolean case_insensitive;
@@ -4912,44 +4999,81 @@ gtk_text_iter_forward_search (const GtkTextIter *iter,
 
   lines = strbreakup (str, "\n", -1, NULL, case_insensitive);
 
+  retval = forward_search_lines (iter, (const gchar **) lines,
+                                 visible_only, slice, case_insensitive,
+                                 match_start, match_end, limit);
+
+  g_strfreev ((gchar**)lines);
+
+  return retval;
+}
+
+/**
+ * gtk_text_iter_forward_search_all:
+ * @iter: start of search
+ * @str: a nonempty search string
+ * @flags: flags affecting how the search is done
+ * @limit: (allow-none): location of last possible match end, or %NULL for the end of the buffer
+ * @func: (scope call): function to call for each match
+ * @user_data: user data for @func
+ *
+ * Searches forward for all non-overlapping occurrences of @str
+ * and calls @func for each of them, until @func returns %FALSE or
+ * @limit is reached. Matches are found like with
+ * gtk_text_iter_forward_search(), but the search string is only
+ * prepared once for all of them.
+ *
+ * @func must not modify the buffer. To apply tags to all matches,
+ * collect their offsets and apply the tags afterwards. To process
+ * a big buffer in batches, return %FALSE from @func after a number
+ * of matches and continue from the end of the last match later.
+ *
+ * Returns: the number of matches passed to @func
+ **/
+guint
+gtk_text_iter_forward_search_all (const GtkTextIter *iter,
+                                  const gchar       *str,
+                                  GtkTextSearchFlags flags,
+                                  const GtkTextIter *limit,
+                                  GtkTextSearchFunc  func,
+                                  gpointer           user_data)
+{
+  gchar **lines;
+  GtkTextIter search, match_start, match_end;
+  gboolean visible_only;
+  gboolean slice;
+  gboolean case_insensitive;
+  guint n_matches;
+
+  g_return_val_if_fail (iter != NULL, 0);
+  g_return_val_if_fail (str != NULL && *str != '\0', 0);
+  g_return_val_if_fail (func != NULL, 0);
+
+  visible_only = (flags & GTK_TEXT_SEARCH_VISIBLE_ONLY) != 0;
+  slice = (flags & GTK_TEXT_SEARCH_TEXT_ONLY) == 0;
+  case_insensitive = (flags & GTK_TEXT_SEARCH_CASE_INSENSITIVE) != 0;
+
+  lines = strbreakup (str, "\n", -1, NULL, case_insensitive);
+
+  n_matches = 0;
   search = *iter;
 
-  do
+  while (forward_search_lines (&search, (const gchar **) lines,
+                               visible_only, slice, case_insensitive,
+                               &match_start, &match_end, limit))
     {
-      /* This loop has an inefficient worst-case, where
-       * gtk_text_iter_get_text() is called repeatedly on
-       * a single line.
-       */
-      GtkTextIter end;
+      n_matches++;
 
-      if (limit &&
-          gtk_text_iter_compare (&search, limit) >= 0)
+      if (!func (&match_start, &match_end, user_data))
         break;
-      
-      if (lines_match (&search, (const gchar**)lines,
-                       visible_only, slice, case_insensitive, &match, &end))
-        {
-          if (limit == NULL ||
-              (limit &&
-               gtk_text_iter_compare (&end, limit) <= 0))
-            {
-              retval = TRUE;
-              
-              if (match_start)
-                *match_start = match;
-              
-              if (match_end)
-                *match_end = end;
-            }
-          
-          break;
-        }
+
+      /* A match can't be empty since the search string isn't */
+      search = match_end;
     }
-  while (gtk_text_iter_forward_line (&search));
 
-  g_strfreev ((gchar**)lines);
+  g_strfreev (lines);
 
-  return retval;
+  return n_matches;
 }
 
 static gboolean
@@ -384,6 +384,29 @@ gboolean gtk_text_iter_backward_search (const GtkTextIter *iter,
                                         GtkTextIter       *match_end,
                                         const GtkTextIter *limit);
 
+/**
+ * GtkTextSearchFunc:
+ * @match_start: the start of the match
+ * @match_end: the end of the match
+ * @user_data: (closure): user data passed to gtk_text_iter_forward_search_all()
+ *
+ * The type of function called by gtk_text_iter_forward_search_all()
+ * for every match. It must not modify the buffer.
+ *
+ * Returns: %TRUE to continue searching, %FALSE to stop
+ */
+typedef gboolean (* GtkTextSearchFunc) (const GtkTextIter *match_start,
+                                        const GtkTextIter *match_end,
+                                        gpointer           user_data);
+
+GDK_AVAILABLE_IN_ALL
+guint    gtk_text_iter_forward_search_all (const GtkTextIter *iter,
+                                           const gchar       *str,
+                                           GtkTextSearchFlags flags,
+                                           const GtkTextIter *limit,
+                                           GtkTextSearchFunc  func,
+                                           gpointer           user_data);
+
 /*
  * Comparisons
  */
@@ -87,6 +87,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* The number of line displays that are kept around at least, more are
+ * kept when more lines are visible, see gtk_text_layout_set_n_visible_lines().
+ */
+#define MIN_DISPLAY_CACHE_SIZE 32
+
+#define VALIDATE_CHUNK_PIXELS 256
+
+#define MAX_STYLE_CACHE_SIZE 256
+
 #define GTK_TEXT_LAYOUT_GET_PRIVATE(o)  ((GtkTextLayoutPrivate *) gtk_text_layout_get_instance_private ((o)))
 
 typedef struct _GtkTextLayoutPrivate GtkTextLayoutPrivate;
@@ -126,6 +135,7 @@ static void gtk_text_layout_emit_changed           (GtkTextLayout     *layout,
 						    gint               new_height);
 
 static void gtk_text_layout_invalidate_all (GtkTextLayout *layout);
+static void gtk_text_layout_clear_display_cache (GtkTextLayout *layout);
 
 static PangoAttribute *gtk_text_attr_appearance_new (const GtkTextAppearance *appearance);
 
@@ -193,12 +203,7 @@ gtk_text_layout_dispose (GObject *object)
   g_clear_object (&layout->ltr_context);
   g_clear_object (&layout->rtl_context);
 
-  if (layout->one_display_cache)
-    {
-      GtkTextLineDisplay *tmp_display = layout->one_display_cache;
-      layout->one_display_cache = NULL;
-      gtk_text_layout_free_line_display (layout, tmp_display);
-    }
+  gtk_text_layout_clear_display_cache (layout);
 
   if (layout->preedit_attrs != NULL)
     {
@@ -217,6 +222,8 @@ gtk_text_layout_finalize (GObject *object)
   layout = GTK_TEXT_LAYOUT (object);
 
   g_free (layout->preedit_string);
+  g_hash_table_destroy (layout->display_cache_lines);
+  g_hash_table_destroy (layout->style_cache);
 
   G_OBJECT_CLASS (gtk_text_layout_parent_class)->finalize (object);
 }
@@ -273,10 +280,45 @@ gtk_text_layout_class_init (GtkTextLayoutClass *klass)
                   G_TYPE_INT);
 }
 
+/* The tags arrays used as keys are sorted by priority, so every
+ * combination of tags has exactly one key.
+ */
+static guint
+tags_array_hash (gconstpointer data)
+{
+  const GPtrArray *tags = data;
+  guint hash = tags->len;
+  guint i;
+
+  for (i = 0; i < tags->len; i++)
+    hash = (hash << 5) - hash + g_direct_hash (g_ptr_array_index (tags, i));
+
+  return hash;
+}
+
+static gboolean
+tags_array_equal (gconstpointer a,
+                  gconstpointer b)
+{
+  const GPtrArray *tags_a = a;
+  const GPtrArray *tags_b = b;
+
+  return tags_a->len == tags_b->len &&
+         memcmp (tags_a->pdata, tags_b->pdata, tags_a->len * sizeof (gpointer)) == 0;
+}
+
 static void
 gtk_text_layout_init (GtkTextLayout *text_layout)
 {
   text_layout->cursor_visible = TRUE;
+
+  g_queue_init (&text_layout->display_cache);
+  text_layout->display_cache_lines = g_hash_table_new (NULL, NULL);
+  text_layout->display_cache_size = MIN_DISPLAY_CACHE_SIZE;
+  text_layout->style_cache = g_hash_table_new_full (tags_array_hash,
+                                                    tags_array_equal,
+                                                    (GDestroyNotify) g_ptr_array_unref,
+                                                    (GDestroyNotify) gtk_text_attributes_unref);
 }
 
 GtkTextLayout*
@@ -295,6 +337,16 @@ free_style_cache (GtkTextLayout *text_layout)
     }
 }
 
+/* Also called when tags change or go away, since the cache
+ * holds on to the tag pointers without owning them.
+ */
+static void
+clear_style_cache (GtkTextLayout *text_layout)
+{
+  free_style_cache (text_layout);
+  g_hash_table_remove_all (text_layout->style_cache);
+}
+
 /**
  * gtk_text_layout_set_buffer:
  * @buffer: (allow-none):
@@ -309,13 +361,20 @@ gtk_text_layout_set_buffer (GtkTextLayout *layout,
   if (layout->buffer == buffer)
     return;
 
-  free_style_cache (layout);
+  clear_style_cache (layout);
+  gtk_text_layout_clear_display_cache (layout);
 
   if (layout->buffer)
     {
+      GtkTextTagTable *table = gtk_text_buffer_get_tag_table (layout->buffer);
+
       _gtk_text_btree_remove_view (_gtk_text_buffer_get_btree (layout->buffer),
                                   layout);
 
+      g_signal_handlers_disconnect_by_func (table,
+                                            G_CALLBACK (clear_style_cache),
+                                            layout);
+
       g_signal_handlers_disconnect_by_func (layout->buffer, 
                                             G_CALLBACK (gtk_text_layout_mark_set_handler), 
                                             layout);
@@ -346,6 +405,11 @@ gtk_text_layout_set_buffer (GtkTextLayout *layout,
       g_signal_connect_after (layout->buffer, "delete-range",
                               G_CALLBACK (gtk_text_layout_buffer_delete_range), layout);
 
+      g_signal_connect_swapped (gtk_text_buffer_get_tag_table (buffer), "tag-changed",
+                                G_CALLBACK (clear_style_cache), layout);
+      g_signal_connect_swapped (gtk_text_buffer_get_tag_table (buffer), "tag-removed",
+                                G_CALLBACK (clear_style_cache), layout);
+
       gtk_text_layout_update_cursor_line (layout);
     }
 }
@@ -356,6 +420,7 @@ gtk_text_layout_default_style_changed (GtkTextLayout *layout)
   g_return_if_fail (GTK_IS_TEXT_LAYOUT (layout));
 
   DV (g_print ("invalidating all due to default style change (%s)\n", G_STRLOC));
+  clear_style_cache (layout);
   gtk_text_layout_invalidate_all (layout);
 }
 
@@ -635,20 +700,58 @@ text_layout_changed (GtkTextLayout *layout,
                      gint           new_height,
                      gboolean       cursors_only)
 {
-  /* Check if the range intersects our cached line display,
-   * and invalidate the cached line if so.
+  GtkTextBTree *btree = _gtk_text_buffer_get_btree (layout->buffer);
+  GtkTextLine *line;
+  gint line_top;
+  guint n_lines, max_lines;
+  GList *l, *next;
+
+  /* Invalidate the cached displays of the lines in the range. Finding
+   * a line's position is a walk up the btree, so walk the range and
+   * look its lines up in the cache instead of looking up the position
+   * of every cached line, unless the range has more lines than the
+   * cache.
    */
+  max_lines = layout->display_cache.length + 1;
+  line = _gtk_text_btree_find_line_by_y (btree, layout, y, &line_top);
+  for (n_lines = 0; n_lines < max_lines; n_lines++)
+    {
+      GtkTextLineData *line_data;
+
+      if (line == NULL || line_top >= y + old_height)
+        goto out;
+
+      gtk_text_layout_invalidate_cache (layout, line, cursors_only);
+
+      line_data = _gtk_text_line_get_data (line, layout);
+      if (line_data)
+        line_top += line_data->height;
+
+      line = _gtk_text_line_next_excluding_last (line);
+    }
+
   if (layout->one_display_cache)
     {
-      GtkTextLine *line = layout->one_display_cache->line;
-      gint cache_y = _gtk_text_btree_find_line_top (_gtk_text_buffer_get_btree (layout->buffer),
-						    line, layout);
+      GtkTextLine *cache_line = layout->one_display_cache->line;
+      gint cache_y = _gtk_text_btree_find_line_top (btree, cache_line, layout);
       gint cache_height = layout->one_display_cache->height;
 
       if (cache_y + cache_height > y && cache_y < y + old_height)
-	gtk_text_layout_invalidate_cache (layout, line, cursors_only);
+	gtk_text_layout_invalidate_cache (layout, cache_line, cursors_only);
+    }
+
+  for (l = layout->display_cache.head; l != NULL; l = next)
+    {
+      GtkTextLineDisplay *display = l->data;
+      gint cache_y = _gtk_text_btree_find_line_top (btree, display->line, layout);
+
+      next = l->next;
+
+      if (cache_y + display->height > y && cache_y < y + old_height)
+	gtk_text_layout_invalidate_cache (layout, display->line, cursors_only);
     }
 
+out:
   gtk_text_layout_emit_changed (layout, y, old_height, new_height);
 }
 
@@ -813,28 +916,119 @@ gtk_text_layout_invalidate_all (GtkTextLayout *layout)
   gtk_text_layout_invalidate (layout, &start, &end);
 }
 
+static GtkTextLineDisplay *
+find_cached_line_display (GtkTextLayout *layout,
+                          GtkTextLine   *line)
+{
+  GList *link;
+
+  if (layout->one_display_cache && line == layout->one_display_cache->line)
+    return layout->one_display_cache;
+
+  link = g_hash_table_lookup (layout->display_cache_lines, line);
+  if (link)
+    return link->data;
+
+  return NULL;
+}
+
+static void
+free_cached_line_display (GtkTextLayout      *layout,
+                          GtkTextLineDisplay *display)
+{
+  if (display == layout->one_display_cache)
+    {
+      layout->one_display_cache = NULL;
+    }
+  else
+    {
+      GList *link = g_hash_table_lookup (layout->display_cache_lines, display->line);
+
+      g_hash_table_remove (layout->display_cache_lines, display->line);
+      g_queue_delete_link (&layout->display_cache, link);
+    }
+
+  display->cached = FALSE;
+  gtk_text_layout_free_line_display (layout, display);
+}
+
+static void
+cache_line_display (GtkTextLayout      *layout,
+                    GtkTextLineDisplay *display)
+{
+  display->cached = TRUE;
+
+  /* Displays for their size only are needed once while validating.
+   * Lines without line data are not told about their removal, so
+   * their displays must not outlive the next call.
+   */
+  if (display->size_only ||
+      _gtk_text_line_get_data (display->line, layout) == NULL)
+    {
+      if (layout->one_display_cache)
+        free_cached_line_display (layout, layout->one_display_cache);
+
+      layout->one_display_cache = display;
+      return;
+    }
+
+  g_queue_push_head (&layout->display_cache, display);
+  g_hash_table_insert (layout->display_cache_lines,
+                       display->line, layout->display_cache.head);
+
+  while (layout->display_cache.length > layout->display_cache_size)
+    free_cached_line_display (layout, g_queue_peek_tail (&layout->display_cache));
+}
+
+static void
+gtk_text_layout_clear_display_cache (GtkTextLayout *layout)
+{
+  if (layout->one_display_cache)
+    free_cached_line_display (layout, layout->one_display_cache);
+
+  while (!g_queue_is_empty (&layout->display_cache))
+    free_cached_line_display (layout, g_queue_peek_head (&layout->display_cache));
+}
+
+/**
+ * gtk_text_layout_set_n_visible_lines:
+ * @layout: a #GtkTextLayout
+ * @n_lines: the number of lines that are currently visible
+ *
+ * Lets the layout keep the displays of all visible lines around, and
+ * as many lines again, so that redrawing and scrolling can reuse them.
+ */
+void
+gtk_text_layout_set_n_visible_lines (GtkTextLayout *layout,
+                                     guint          n_lines)
+{
+  g_return_if_fail (GTK_IS_TEXT_LAYOUT (layout));
+
+  layout->display_cache_size = MAX (MIN_DISPLAY_CACHE_SIZE, 2 * n_lines);
+}
+
 static void
 gtk_text_layout_invalidate_cache (GtkTextLayout *layout,
                                   GtkTextLine   *line,
 				  gboolean       cursors_only)
 {
-  if (layout->one_display_cache && line == layout->one_display_cache->line)
-    {
-      GtkTextLineDisplay *display = layout->one_display_cache;
+  GtkTextLineDisplay *display;
 
-      if (cursors_only)
-	{
-          if (display->cursors)
-            g_array_free (display->cursors, TRUE);
-	  display->cursors = NULL;
-	  display->cursors_invalid = TRUE;
-	  display->has_block_cursor = FALSE;
-	}
-      else
-	{
-	  layout->one_display_cache = NULL;
-	  gtk_text_layout_free_line_display (layout, display);
-	}
+  display = find_cached_line_display (layout, line);
+  if (display == NULL)
+    return;
+
+  if (cursors_only)
+    {
+      if (display->cursors)
+        g_array_free (display->cursors, TRUE);
+      display->cursors = NULL;
+      display->cursors_invalid = TRUE;
+      display->has_block_cursor = FALSE;
+    }
+  else
+    {
+      free_cached_line_display (layout, display);
     }
 }
 
@@ -926,32 +1120,40 @@ gtk_text_layout_real_invalidate_cursors (GtkTextLayout     *layout,
 					 const GtkTextIter *start,
 					 const GtkTextIter *end)
 {
-  /* Check if the range intersects our cached line display,
-   * and invalidate the cached line if so.
+  GtkTextLine *start_line, *end_line;
+  gint start_number, end_number;
+  GList *l;
+
+  if (gtk_text_iter_compare (start, end) > 0)
+    {
+      const GtkTextIter *tmp = start;
+      start = end;
+      end = tmp;
+    }
+
+  start_line = _gtk_text_iter_get_text_line (start);
+  end_line = _gtk_text_iter_get_text_line (end);
+  start_number = _gtk_text_line_get_number (start_line);
+  end_number = _gtk_text_line_get_number (end_line);
+
+  /* Check if the range intersects our cached line displays,
+   * and invalidate the cursors of the cached lines if so.
    */
   if (layout->one_display_cache)
     {
-      GtkTextIter line_start, line_end;
-      GtkTextLine *line = layout->one_display_cache->line;
-
-      gtk_text_layout_get_iter_at_line (layout, &line_start, line, 0);
+      gint number = _gtk_text_line_get_number (layout->one_display_cache->line);
 
-      line_end = line_start;
-      if (!gtk_text_iter_ends_line (&line_end))
-	gtk_text_iter_forward_to_line_end (&line_end);
+      if (number >= start_number && number <= end_number)
+	gtk_text_layout_invalidate_cache (layout, layout->one_display_cache->line, TRUE);
+    }
 
-      if (gtk_text_iter_compare (start, end) > 0)
-	{
-	  const GtkTextIter *tmp = start;
-	  start = end;
-	  end = tmp;
-	}
+  for (l = layout->display_cache.head; l != NULL; l = l->next)
+    {
+      GtkTextLineDisplay *display = l->data;
+      gint number = _gtk_text_line_get_number (display->line);
 
-      if (gtk_text_iter_compare (&line_start, end) <= 0 &&
-	  gtk_text_iter_compare (start, &line_end) <= 0)
-	{
-	  gtk_text_layout_invalidate_cache (layout, line, TRUE);
-	}
+      if (number >= start_number && number <= end_number)
+	gtk_text_layout_invalidate_cache (layout, display->line, TRUE);
     }
 
   gtk_text_layout_invalidated (layout);
@@ -1159,6 +1361,49 @@ gtk_text_layout_validate (GtkTextLayout *layout,
     }
 }
 
+/**
+ * gtk_text_layout_validate_for_time:
+ * @layout: a #GtkTextLayout
+ * @max_usec: the time budget in microseconds
+ *
+ * Validate regions of a #GtkTextLayout until @max_usec microseconds
+ * have passed. The time is checked after each chunk of a few hundred
+ * pixels of paragraphs, so unlike gtk_text_layout_validate() the amount
+ * of work done adapts to how expensive the lines are to wrap. The
+ * ::changed signal will be emitted for each region validated.
+ *
+ * Returns: %TRUE if the layout still has invalid regions
+ **/
+gboolean
+gtk_text_layout_validate_for_time (GtkTextLayout *layout,
+                                   gint64         max_usec)
+{
+  GtkTextBTree *btree;
+  gint64 end_time;
+  gint y, old_height, new_height;
+
+  g_return_val_if_fail (GTK_IS_TEXT_LAYOUT (layout), FALSE);
+
+  btree = _gtk_text_buffer_get_btree (layout->buffer);
+  end_time = g_get_monotonic_time () + max_usec;
+
+  /* Validate in small chunks so that the clock is checked often,
+   * but not after every line, which would mean walking the btree
+   * from the root for each of them.
+   */
+  while (_gtk_text_btree_validate (btree, layout, VALIDATE_CHUNK_PIXELS,
+                                   &y, &old_height, &new_height))
+    {
+      update_layout_size (layout);
+      gtk_text_layout_emit_changed (layout, y, old_height, new_height);
+
+      if (g_get_monotonic_time () >= end_time)
+        return !gtk_text_layout_is_valid (layout);
+    }
+
+  return FALSE;
+}
+
 static GtkTextLineData*
 gtk_text_layout_real_wrap (GtkTextLayout   *layout,
                            GtkTextLine     *line,
@@ -1225,16 +1470,31 @@ get_style (GtkTextLayout *layout,
       return layout->default_style;
     }
 
-  style = gtk_text_attributes_new ();
+  style = g_hash_table_lookup (layout->style_cache, tags);
+  if (style == NULL)
+    {
+      GPtrArray *key;
+      guint i;
+
+      if (g_hash_table_size (layout->style_cache) >= MAX_STYLE_CACHE_SIZE)
+        g_hash_table_remove_all (layout->style_cache);
+
+      style = gtk_text_attributes_new ();
 
-  gtk_text_attributes_copy_values (layout->default_style,
-                                   style);
+      gtk_text_attributes_copy_values (layout->default_style,
+                                       style);
 
-  _gtk_text_attributes_fill_from_tags (style,
-                                       (GtkTextTag**) tags->pdata,
-                                       tags->len);
+      _gtk_text_attributes_fill_from_tags (style,
+                                           (GtkTextTag**) tags->pdata,
+                                           tags->len);
 
-  g_assert (style->refcount == 1);
+      key = g_ptr_array_sized_new (tags->len);
+      for (i = 0; i < tags->len; i++)
+        g_ptr_array_add (key, g_ptr_array_index (tags, i));
+
+      /* The initial ref is held by the style cache */
+      g_hash_table_insert (layout->style_cache, key, style);
+    }
 
   /* Leave this style as the last one seen */
   g_assert (layout->one_style_cache == NULL);
@@ -1242,6 +1502,7 @@ get_style (GtkTextLayout *layout,
   layout->one_style_cache = style;
 
   /* Returning yet another refcount */
+  gtk_text_attributes_ref (style);
   return style;
 }
 
@@ -2268,20 +2529,26 @@ gtk_text_layout_get_line_display (GtkTextLayout *layout,
   
   g_return_val_if_fail (line != NULL, NULL);
 
-  if (layout->one_display_cache)
+  display = find_cached_line_display (layout, line);
+  if (display)
     {
-      if (line == layout->one_display_cache->line &&
-          (size_only || !layout->one_display_cache->size_only))
+      if (size_only || !display->size_only)
 	{
+          if (display != layout->one_display_cache)
+            {
+              GList *link = g_hash_table_lookup (layout->display_cache_lines, line);
+
+              g_queue_unlink (&layout->display_cache, link);
+              g_queue_push_head_link (&layout->display_cache, link);
+            }
+
 	  if (!size_only)
-            update_text_display_cursors (layout, line, layout->one_display_cache);
-	  return layout->one_display_cache;
+            update_text_display_cursors (layout, line, display);
+	  return display;
 	}
       else
         {
-          GtkTextLineDisplay *tmp_display = layout->one_display_cache;
-          layout->one_display_cache = NULL;
-          gtk_text_layout_free_line_display (layout, tmp_display);
+          free_cached_line_display (layout, display);
         }
     }
 
@@ -2607,7 +2874,7 @@ gtk_text_layout_get_line_display (GtkTextLayout *layout,
   if (tags != NULL)
     g_ptr_array_free (tags, TRUE);
 
-  layout->one_display_cache = display;
+  cache_line_display (layout, display);
 
   if (saw_widget)
     allocate_child_widgets (layout, display);
@@ -2619,11 +2886,14 @@ void
 gtk_text_layout_free_line_display (GtkTextLayout      *layout,
                                    GtkTextLineDisplay *display)
 {
-  if (display != layout->one_display_cache)
+  if (!display->cached)
     {
       if (display->layout)
         g_object_unref (display->layout);
 
+      if (display->node)
+        gsk_render_node_unref (display->node);
+
       if (display->cursors)
         g_array_free (display->cursors, TRUE);
 
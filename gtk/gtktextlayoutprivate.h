@@ -138,11 +138,22 @@ struct _GtkTextLayout
    * over long runs with the same style. */
   GtkTextAttributes *one_style_cache;
 
-  /* A cache of one line display. Getting the same line
-   * many times in a row is the most common case.
+  /* The styles computed for the tag combinations seen so far,
+   * so lines with the same tags share their GtkTextAttributes. */
+  GHashTable *style_cache;
+
+  /* A cache of one line display that is not worth keeping around
+   * for long, e.g. one only computed for its size while validating.
    */
   GtkTextLineDisplay *one_display_cache;
 
+  /* The most recently used line displays, most recent first. Drawing
+   * and scrolling get the same lines over and over again.
+   */
+  GQueue display_cache;
+  GHashTable *display_cache_lines; /* GtkTextLine => GList link in display_cache */
+  guint display_cache_size;
+
   /* Whether we are allowed to wrap right now */
   gint wrap_loop_count;
   
@@ -245,8 +256,21 @@ struct _GtkTextLineDisplay
   guint has_block_cursor : 1;
   guint cursor_at_line_end : 1;
   guint size_only : 1;
+  guint cached : 1;
 
   GdkRGBA *pg_bg_rgba;
+
+  /* The rendered line, kept for as long as it is drawn the same way,
+   * see gtk_text_layout_snapshot()
+   */
+  GskRenderNode *node;
+  GdkRectangle node_area;
+  gint node_selection_start;
+  gint node_selection_end;
+  GtkStateFlags node_state;
+  GdkRectangle node_block_cursor;
+  gint node_insert_index;
+  guint node_has_block_cursor : 1;
 };
 
 #ifdef GTK_COMPILATION
@@ -327,6 +351,9 @@ GtkTextLineDisplay* gtk_text_layout_get_line_display  (GtkTextLayout      *layou
 GDK_AVAILABLE_IN_ALL
 void                gtk_text_layout_free_line_display (GtkTextLayout      *layout,
                                                        GtkTextLineDisplay *display);
+GDK_AVAILABLE_IN_ALL
+void                gtk_text_layout_set_n_visible_lines (GtkTextLayout    *layout,
+                                                         guint             n_lines);
 
 GDK_AVAILABLE_IN_ALL
 void gtk_text_layout_get_line_at_y     (GtkTextLayout     *layout,
@@ -367,6 +394,9 @@ void     gtk_text_layout_validate_yrange (GtkTextLayout *layout,
 GDK_AVAILABLE_IN_ALL
 void     gtk_text_layout_validate        (GtkTextLayout *layout,
                                           gint           max_pixels);
+GDK_AVAILABLE_IN_ALL
+gboolean gtk_text_layout_validate_for_time (GtkTextLayout *layout,
+                                            gint64         max_usec);
 
 /* This function should return the passed-in line data,
  * OR remove the existing line data from the line, and
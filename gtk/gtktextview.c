@@ -146,6 +146,8 @@
 #define SPACE_FOR_CURSOR 1
 #define CURSOR_ASPECT_RATIO (0.04)
 
+#define INCREMENTAL_VALIDATE_USEC 8000 /* half a frame at 60Hz */
+
 typedef struct _GtkTextWindow GtkTextWindow;
 typedef struct _GtkTextPendingScroll GtkTextPendingScroll;
 
@@ -4289,15 +4291,18 @@ incremental_validate_callback (gpointer data)
 
   DV(g_print(G_STRLOC"\n"));
   
-  gtk_text_layout_validate (text_view->priv->layout, 2000);
+  /* Work for a fixed amount of time instead of a fixed number of
+   * pixels, so that we validate as much as possible without making
+   * the frame clock miss frames, no matter how long the lines are.
+   */
+  if (!gtk_text_layout_validate_for_time (text_view->priv->layout,
+                                          INCREMENTAL_VALIDATE_USEC))
+    result = FALSE;
 
   gtk_text_view_update_adjustments (text_view);
   
-  if (gtk_text_layout_is_valid (text_view->priv->layout))
-    {
-      text_view->priv->incremental_validate_idle = 0;
-      result = FALSE;
-    }
+  if (!result)
+    text_view->priv->incremental_validate_idle = 0;
 
   return result;
 }
@@ -4557,6 +4562,7 @@ gtk_text_view_style_updated (GtkWidget *widget)
     {
       gtk_text_view_set_attributes_from_style (text_view,
                                                priv->layout->default_style);
+      gtk_text_layout_default_style_changed (priv->layout);
 
       ltr_context = gtk_widget_create_pango_context (widget);
       pango_context_set_base_dir (ltr_context, PANGO_DIRECTION_LTR);
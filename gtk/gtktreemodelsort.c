@@ -1884,6 +1884,285 @@ gtk_tree_model_sort_offset_compare_func (gconstpointer a,
   return retval;
 }
 
+/* Sorting on a column with the default compare function is done by
+ * getting the value of every row out of the child model once and
+ * sorting an array of keys, instead of getting two values for every
+ * comparison. Numbers are turned into integers that compare like them
+ * and radix sorted, strings are compared by their collation keys.
+ */
+typedef struct _SortKey SortKey;
+typedef struct _SortStringKey SortStringKey;
+
+struct _SortKey
+{
+  guint64 key;
+  guint   index;
+};
+
+struct _SortStringKey
+{
+  gchar *key;
+  guint  index;
+};
+
+#define SORT_KEY_SIGN_BIT G_GUINT64_CONSTANT (0x8000000000000000)
+
+static guint64
+sort_key_from_double (gdouble value)
+{
+  guint64 bits;
+
+  /* -0.0 and 0.0 compare equal */
+  if (value == 0.0)
+    value = 0.0;
+
+  memcpy (&bits, &value, sizeof (bits));
+
+  if (bits & SORT_KEY_SIGN_BIT)
+    return ~bits;
+  else
+    return bits | SORT_KEY_SIGN_BIT;
+}
+
+static guint64
+sort_key_from_value (const GValue *value)
+{
+  switch (G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (value)))
+    {
+    case G_TYPE_BOOLEAN:
+      return g_value_get_boolean (value) ? 1 : 0;
+    case G_TYPE_CHAR:
+      return (guint64) (gint64) g_value_get_schar (value) ^ SORT_KEY_SIGN_BIT;
+    case G_TYPE_UCHAR:
+      return g_value_get_uchar (value);
+    case G_TYPE_INT:
+      return (guint64) (gint64) g_value_get_int (value) ^ SORT_KEY_SIGN_BIT;
+    case G_TYPE_UINT:
+      return g_value_get_uint (value);
+    case G_TYPE_LONG:
+      return (guint64) (gint64) g_value_get_long (value) ^ SORT_KEY_SIGN_BIT;
+    case G_TYPE_ULONG:
+      return g_value_get_ulong (value);
+    case G_TYPE_INT64:
+      return (guint64) g_value_get_int64 (value) ^ SORT_KEY_SIGN_BIT;
+    case G_TYPE_UINT64:
+      return g_value_get_uint64 (value);
+    case G_TYPE_ENUM:
+      return (guint64) (gint64) g_value_get_enum (value) ^ SORT_KEY_SIGN_BIT;
+    case G_TYPE_FLAGS:
+      return g_value_get_flags (value);
+    case G_TYPE_FLOAT:
+      return sort_key_from_double (g_value_get_float (value));
+    case G_TYPE_DOUBLE:
+      return sort_key_from_double (g_value_get_double (value));
+    default:
+      g_assert_not_reached ();
+      return 0;
+    }
+}
+
+/* Stable LSD radix sort, skipping the bytes that are the same for all keys */
+static void
+sort_keys_radix (SortKey *keys,
+                 guint    n_keys)
+{
+  SortKey *buffer, *src, *dest;
+  guint count[256];
+  guint shift, i;
+
+  buffer = g_new (SortKey, n_keys);
+  src = keys;
+  dest = buffer;
+
+  for (shift = 0; shift < 64; shift += 8)
+    {
+      guint pos;
+
+      memset (count, 0, sizeof (count));
+      for (i = 0; i < n_keys; i++)
+        count[(src[i].key >> shift) & 0xff]++;
+
+      if (count[(src[0].key >> shift) & 0xff] == n_keys)
+        continue;
+
+      pos = 0;
+      for (i = 0; i < 256; i++)
+        {
+          guint n = count[i];
+
+          count[i] = pos;
+          pos += n;
+        }
+
+      for (i = 0; i < n_keys; i++)
+        dest[count[(src[i].key >> shift) & 0xff]++] = src[i];
+
+      src = dest;
+      dest = src == keys ? buffer : keys;
+    }
+
+  if (src != keys)
+    memcpy (keys, src, sizeof (SortKey) * n_keys);
+
+  g_free (buffer);
+}
+
+static gint
+sort_string_key_compare (gconstpointer a,
+                         gconstpointer b,
+                         gpointer      user_data)
+{
+  const SortStringKey *ka = a;
+  const SortStringKey *kb = b;
+  gint retval;
+
+  retval = strcmp (ka->key, kb->key);
+
+  if (GPOINTER_TO_INT (user_data) == GTK_SORT_DESCENDING)
+    retval = -retval;
+
+  /* keep rows that compare equal in their current order */
+  if (retval == 0)
+    retval = ka->index < kb->index ? -1 : 1;
+
+  return retval;
+}
+
+static void
+get_child_iter_for_sort (SortData    *data,
+                         SortElt     *elt,
+                         GtkTreeIter *child_iter)
+{
+  GtkTreeModelSortPrivate *priv = data->tree_model_sort->priv;
+
+  if (GTK_TREE_MODEL_SORT_CACHE_CHILD_ITERS (data->tree_model_sort))
+    {
+      *child_iter = elt->iter;
+    }
+  else
+    {
+      data->parent_path_indices [data->parent_path_depth-1] = elt->offset;
+      gtk_tree_model_get_iter (priv->child_model, child_iter, data->parent_path);
+    }
+}
+
+/* Returns %FALSE if the level has to be sorted with the compare function */
+static gboolean
+gtk_tree_model_sort_sort_level_by_key (GtkTreeModelSort *tree_model_sort,
+                                       SortLevel        *level,
+                                       SortData         *data)
+{
+  GtkTreeModelSortPrivate *priv = tree_model_sort->priv;
+  GSequenceIter *siter, *end_siter;
+  GtkTreeIter child_iter;
+  SortElt **elts;
+  guint *order;
+  gboolean is_string;
+  gint column;
+  guint n, i;
+
+  if (data->sort_func != _gtk_tree_data_list_compare_func)
+    return FALSE;
+
+  column = GPOINTER_TO_INT (data->sort_data);
+
+  switch (G_TYPE_FUNDAMENTAL (gtk_tree_model_get_column_type (priv->child_model, column)))
+    {
+    case G_TYPE_BOOLEAN:
+    case G_TYPE_CHAR:
+    case G_TYPE_UCHAR:
+    case G_TYPE_INT:
+    case G_TYPE_UINT:
+    case G_TYPE_LONG:
+    case G_TYPE_ULONG:
+    case G_TYPE_INT64:
+    case G_TYPE_UINT64:
+    case G_TYPE_ENUM:
+    case G_TYPE_FLAGS:
+    case G_TYPE_FLOAT:
+    case G_TYPE_DOUBLE:
+      is_string = FALSE;
+      break;
+    case G_TYPE_STRING:
+      is_string = TRUE;
+      break;
+    default:
+      return FALSE;
+    }
+
+  n = g_sequence_get_length (level->seq);
+  elts = g_new (SortElt *, n);
+  order = g_new (guint, n);
+
+  i = 0;
+  end_siter = g_sequence_get_end_iter (level->seq);
+  for (siter = g_sequence_get_begin_iter (level->seq);
+       siter != end_siter;
+       siter = g_sequence_iter_next (siter))
+    elts[i++] = g_sequence_get (siter);
+
+  if (is_string)
+    {
+      SortStringKey *keys = g_new (SortStringKey, n);
+
+      for (i = 0; i < n; i++)
+        {
+          GValue value = G_VALUE_INIT;
+          const gchar *str;
+
+          get_child_iter_for_sort (data, elts[i], &child_iter);
+          gtk_tree_model_get_value (priv->child_model, &child_iter, column, &value);
+          str = g_value_get_string (&value);
+          keys[i].key = g_utf8_collate_key (str ? str : "", -1);
+          keys[i].index = i;
+          g_value_unset (&value);
+        }
+
+      g_qsort_with_data (keys, n, sizeof (SortStringKey),
+                         sort_string_key_compare, GINT_TO_POINTER (priv->order));
+
+      for (i = 0; i < n; i++)
+        {
+          order[i] = keys[i].index;
+          g_free (keys[i].key);
+        }
+
+      g_free (keys);
+    }
+  else
+    {
+      SortKey *keys = g_new (SortKey, n);
+      guint64 flip = priv->order == GTK_SORT_DESCENDING ? G_MAXUINT64 : 0;
+
+      for (i = 0; i < n; i++)
+        {
+          GValue value = G_VALUE_INIT;
+
+          get_child_iter_for_sort (data, elts[i], &child_iter);
+          gtk_tree_model_get_value (priv->child_model, &child_iter, column, &value);
+          keys[i].key = sort_key_from_value (&value) ^ flip;
+          keys[i].index = i;
+          g_value_unset (&value);
+        }
+
+      sort_keys_radix (keys, n);
+
+      for (i = 0; i < n; i++)
+        order[i] = keys[i].index;
+
+      g_free (keys);
+    }
+
+  /* moving every element to the end in turn leaves them in sorted order */
+  for (i = 0; i < n; i++)
+    g_sequence_move (elts[order[i]]->siter, end_siter);
+
+  g_free (order);
+  g_free (elts);
+
+  return TRUE;
+}
+
 static void
 gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
 				SortLevel        *level,
@@ -1932,7 +2211,7 @@ gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
   if (data.sort_func == NO_SORT_FUNC)
     g_sequence_sort (level->seq, gtk_tree_model_sort_offset_compare_func,
                      &data);
-  else
+  else if (!gtk_tree_model_sort_sort_level_by_key (tree_model_sort, level, &data))
     g_sequence_sort (level->seq, gtk_tree_model_sort_compare_func, &data);
 
   free_sort_data (&data);
@@ -127,6 +127,12 @@ void		  gtk_tree_view_column_cell_snapshot     (GtkTreeViewColumn  *tree_column,
                                                           gboolean            draw_focus);
 void		  _gtk_tree_view_column_cell_set_dirty	 (GtkTreeViewColumn  *tree_column,
 							  gboolean            install_handler);
+void              _gtk_tree_view_column_measure_row      (GtkTreeViewColumn  *tree_column,
+                                                          GtkTreeModel       *tree_model,
+                                                          GtkTreeIter        *iter,
+                                                          gboolean            is_expander,
+                                                          gboolean            is_expanded,
+                                                          gint               *height);
 gboolean          _gtk_tree_view_column_cell_get_dirty   (GtkTreeViewColumn  *tree_column);
 
 void              _gtk_tree_view_column_push_padding          (GtkTreeViewColumn  *column,
@@ -499,6 +499,81 @@ gtk_tree_rbtree_insert_after (GtkTreeRBTree *tree,
   return node;
 }
 
+/* Builds a balanced subtree from @n_nodes new nodes. Nodes at
+ * @black_depth or deeper are red, so that all paths through the
+ * subtree have the same number of black nodes. */
+static GtkTreeRBNode *
+gtk_tree_rbnode_new_balanced (GtkTreeRBTree *tree,
+                              guint          n_nodes,
+                              gint           height,
+                              gboolean       valid,
+                              guint          depth,
+                              guint          black_depth)
+{
+  GtkTreeRBNode *node;
+  guint n_left;
+
+  if (n_nodes == 0)
+    return (GtkTreeRBNode *) &nil;
+
+  n_left = n_nodes / 2;
+
+  node = gtk_tree_rbnode_new (tree, height);
+  node->left = gtk_tree_rbnode_new_balanced (tree, n_left, height, valid, depth + 1, black_depth);
+  node->right = gtk_tree_rbnode_new_balanced (tree, n_nodes - n_left - 1, height, valid, depth + 1, black_depth);
+
+  if (!gtk_tree_rbtree_is_nil (node->left))
+    node->left->parent = node;
+  if (!gtk_tree_rbtree_is_nil (node->right))
+    node->right->parent = node;
+
+  if (depth < black_depth)
+    GTK_TREE_RBNODE_SET_COLOR (node, GTK_TREE_RBNODE_BLACK);
+
+  node->count = n_nodes;
+  node->total_count = n_nodes;
+  node->offset = n_nodes * height;
+
+  if (!valid)
+    GTK_TREE_RBNODE_SET_FLAG (node, GTK_TREE_RBNODE_INVALID | GTK_TREE_RBNODE_DESCENDANTS_INVALID);
+
+  return node;
+}
+
+/* Fills the empty @tree with @n_nodes nodes of the given @height.
+ *
+ * This is the same as calling gtk_tree_rbtree_insert_after() @n_nodes
+ * times, but it builds the tree in one go instead of rebalancing it
+ * and updating its parents for every node.
+ */
+void
+gtk_tree_rbtree_fill (GtkTreeRBTree *tree,
+                      guint          n_nodes,
+                      gint           height,
+                      gboolean       valid)
+{
+  guint black_depth;
+
+  g_return_if_fail (gtk_tree_rbtree_is_nil (tree->root));
+
+  if (n_nodes == 0)
+    return;
+
+  /* All levels above this one are completely filled */
+  for (black_depth = 0; ((n_nodes + 1) >> (black_depth + 1)) > 0; black_depth++)
+    ;
+
+  tree->root = gtk_tree_rbnode_new_balanced (tree, n_nodes, height, valid, 0, black_depth);
+
+  gtk_rbnode_adjust (tree->parent_tree, tree->parent_node,
+                     0, tree->root->total_count, tree->root->offset);
+
+#ifdef G_ENABLE_DEBUG
+  if (GTK_DEBUG_CHECK (TREE))
+    gtk_tree_rbtree_test (G_STRLOC, tree);
+#endif
+}
+
 GtkTreeRBNode *
 gtk_tree_rbtree_insert_before (GtkTreeRBTree *tree,
                                GtkTreeRBNode *current,
@@ -757,31 +832,58 @@ gtk_tree_rbtree_mark_invalid (GtkTreeRBTree *tree)
   while ((node = gtk_tree_rbtree_next (tree, node)) != NULL);
 }
 
+/* Fixes up offsets and validity bottom-up, so every node is only
+ * touched once instead of walking up to the root for each of them */
+static void
+gtk_tree_rbnode_set_fixed_height (GtkTreeRBTree *tree,
+                                  GtkTreeRBNode *node,
+                                  gint           height,
+                                  gboolean       mark_valid)
+{
+  gint node_height;
+
+  if (gtk_tree_rbtree_is_nil (node))
+    return;
+
+  node_height = GTK_TREE_RBNODE_GET_HEIGHT (node);
+  if (GTK_TREE_RBNODE_FLAG_SET (node, GTK_TREE_RBNODE_INVALID))
+    {
+      node_height = height;
+      if (mark_valid)
+        GTK_TREE_RBNODE_UNSET_FLAG (node, GTK_TREE_RBNODE_INVALID | GTK_TREE_RBNODE_COLUMN_INVALID);
+    }
+
+  gtk_tree_rbnode_set_fixed_height (tree, node->left, height, mark_valid);
+  gtk_tree_rbnode_set_fixed_height (tree, node->right, height, mark_valid);
+  if (node->children)
+    gtk_tree_rbnode_set_fixed_height (node->children, node->children->root, height, mark_valid);
+
+  node->offset = node->left->offset + node->right->offset + node_height +
+                 (node->children ? node->children->root->offset : 0);
+  fixup_validation (tree, node);
+}
+
 void
 gtk_tree_rbtree_set_fixed_height (GtkTreeRBTree *tree,
                                   gint           height,
                                   gboolean       mark_valid)
 {
-  GtkTreeRBNode *node;
+  gint old_offset;
 
   if (tree == NULL)
     return;
 
-  node = gtk_tree_rbtree_first (tree);
+  old_offset = tree->root->offset;
 
-  do
-    {
-      if (GTK_TREE_RBNODE_FLAG_SET (node, GTK_TREE_RBNODE_INVALID))
-        {
-          gtk_tree_rbtree_node_set_height (tree, node, height);
-          if (mark_valid)
-            gtk_tree_rbtree_node_mark_valid (tree, node);
-        }
+  gtk_tree_rbnode_set_fixed_height (tree, tree->root, height, mark_valid);
 
-      if (node->children)
-        gtk_tree_rbtree_set_fixed_height (node->children, height, mark_valid);
-    }
-  while ((node = gtk_tree_rbtree_next (tree, node)) != NULL);
+  gtk_rbnode_adjust (tree->parent_tree, tree->parent_node,
+                     0, 0, tree->root->offset - old_offset);
+
+#ifdef G_ENABLE_DEBUG
+  if (GTK_DEBUG_CHECK (TREE))
+    gtk_tree_rbtree_test (G_STRLOC, tree);
+#endif
 }
 
 static void
@@ -110,6 +110,10 @@ GtkTreeRBNode * gtk_tree_rbtree_insert_after            (GtkTreeRBTree
                                                          GtkTreeRBNode                 *node,
                                                          gint                           height,
                                                          gboolean                       valid);
+void            gtk_tree_rbtree_fill                    (GtkTreeRBTree                 *tree,
+                                                         guint                          n_nodes,
+                                                         gint                           height,
+                                                         gboolean                       valid);
 void            gtk_tree_rbtree_remove_node             (GtkTreeRBTree                 *tree,
                                                          GtkTreeRBNode                 *node);
 gboolean        gtk_tree_rbtree_is_nil                  (GtkTreeRBNode                 *node);
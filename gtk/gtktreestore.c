@@ -75,6 +75,9 @@ struct _GtkTreeStorePrivate
   gpointer default_sort_data;
   GDestroyNotify default_sort_destroy;
   guint columns_dirty : 1;
+
+  /* row being filled by gtk_tree_store_insert_rows(), not announced yet */
+  gpointer filling_row;
 };
 
 
@@ -954,6 +957,13 @@ gtk_tree_store_set_value (GtkTreeStore *tree_store,
   g_return_if_fail (column >= 0 && column < tree_store->priv->n_columns);
   g_return_if_fail (G_IS_VALUE (value));
 
+  /* gtk_tree_store_insert_rows() takes care of the row once it is filled */
+  if (iter->user_data == tree_store->priv->filling_row)
+    {
+      gtk_tree_store_real_set_value (tree_store, iter, column, value, FALSE);
+      return;
+    }
+
   if (gtk_tree_store_real_set_value (tree_store, iter, column, value, TRUE))
     {
       GtkTreePath *path;
@@ -1108,6 +1118,10 @@ gtk_tree_store_set_valuesv (GtkTreeStore *tree_store,
 				      &maybe_need_sort,
 				      columns, values, n_values);
 
+  /* gtk_tree_store_insert_rows() takes care of the row once it is filled */
+  if (iter->user_data == priv->filling_row)
+    return;
+
   if (maybe_need_sort && GTK_TREE_STORE_IS_SORTED (tree_store))
     gtk_tree_store_sort_iter_changed (tree_store, iter, priv->sort_column_id, TRUE);
 
@@ -1148,6 +1162,10 @@ gtk_tree_store_set_valist (GtkTreeStore *tree_store,
 				      &maybe_need_sort,
 				      var_args);
 
+  /* gtk_tree_store_insert_rows() takes care of the row once it is filled */
+  if (iter->user_data == priv->filling_row)
+    return;
+
   if (maybe_need_sort && GTK_TREE_STORE_IS_SORTED (tree_store))
     gtk_tree_store_sort_iter_changed (tree_store, iter, priv->sort_column_id, TRUE);
 
@@ -1648,6 +1666,147 @@ gtk_tree_store_insert_with_valuesv (GtkTreeStore *tree_store,
   validate_tree ((GtkTreeStore *)tree_store);
 }
 
+/**
+ * gtk_tree_store_insert_rows:
+ * @tree_store: A #GtkTreeStore
+ * @parent: (allow-none): A valid #GtkTreeIter, or %NULL
+ * @position: position to insert the new rows, or -1 to append them
+ * @n_rows: the number of rows to insert
+ * @fill_func: (scope call) (allow-none): function to set the values
+ *     of each new row, or %NULL to insert empty rows
+ * @user_data: user data to pass to @fill_func
+ *
+ * Inserts @n_rows new rows as children of @parent at @position,
+ * calling @fill_func to set the values of each of them. If @parent
+ * is %NULL, the rows are inserted at the toplevel.
+ *
+ * This is considerably faster than calling
+ * gtk_tree_store_insert_with_values() in a loop when loading large
+ * amounts of data, as the rows are linked in one after the other
+ * instead of looking up @position again for every row.
+ *
+ * Setting values from @fill_func does not emit #GtkTreeModel::row-changed
+ * or cause the row to be resorted. Instead, every row is put in place and
+ * #GtkTreeModel::row-inserted is emitted once after @fill_func returned
+ * for it. @fill_func must not modify @tree_store other than by setting
+ * values on the row it is given; in particular it must not add children
+ * to it.
+ *
+ * If the store is sorted, @position is ignored and the rows are inserted
+ * at their sorted positions.
+ */
+void
+gtk_tree_store_insert_rows (GtkTreeStore         *tree_store,
+                            GtkTreeIter          *parent,
+                            gint                  position,
+                            gint                  n_rows,
+                            GtkTreeStoreFillFunc  fill_func,
+                            gpointer              user_data)
+{
+  GtkTreeStorePrivate *priv;
+  GtkTreePath *path;
+  GNode *parent_node;
+  GNode *prev_node;
+  GtkTreeIter iter;
+  gboolean sorted;
+  gboolean had_children;
+  gint i;
+
+  g_return_if_fail (GTK_IS_TREE_STORE (tree_store));
+  g_return_if_fail (n_rows >= 0);
+
+  priv = tree_store->priv;
+  g_return_if_fail (priv->filling_row == NULL);
+
+  if (parent)
+    g_return_if_fail (VALID_ITER (parent, tree_store));
+
+  if (n_rows == 0)
+    return;
+
+  if (parent)
+    parent_node = parent->user_data;
+  else
+    parent_node = priv->root;
+
+  priv->columns_dirty = TRUE;
+  sorted = GTK_TREE_STORE_IS_SORTED (tree_store);
+  had_children = parent_node->children != NULL;
+
+  if (position == 0 || parent_node->children == NULL)
+    {
+      prev_node = NULL;
+      position = 0;
+    }
+  else if (position < 0)
+    {
+      prev_node = g_node_last_child (parent_node);
+      position = g_node_child_position (parent_node, prev_node) + 1;
+    }
+  else
+    {
+      prev_node = g_node_nth_child (parent_node, position - 1);
+      if (prev_node == NULL)
+        {
+          prev_node = g_node_last_child (parent_node);
+          position = g_node_child_position (parent_node, prev_node) + 1;
+        }
+    }
+
+  if (parent)
+    path = gtk_tree_store_get_path (GTK_TREE_MODEL (tree_store), parent);
+  else
+    path = gtk_tree_path_new ();
+  gtk_tree_path_append_index (path, position);
+
+  iter.stamp = priv->stamp;
+
+  for (i = 0; i < n_rows; i++)
+    {
+      GNode *new_node = g_node_new (NULL);
+
+      /* g_node_insert() walks the siblings to find the position, so keep
+       * track of the previous row to not make this quadratic.
+       */
+      g_node_insert_after (parent_node, prev_node, new_node);
+      prev_node = new_node;
+      iter.user_data = new_node;
+
+      if (fill_func)
+        {
+          priv->filling_row = new_node;
+          fill_func (tree_store, &iter, i, user_data);
+          priv->filling_row = NULL;
+        }
+
+      if (sorted)
+        {
+          gtk_tree_store_sort_iter_changed (tree_store, &iter, priv->sort_column_id, FALSE);
+
+          gtk_tree_path_free (path);
+          path = gtk_tree_store_get_path (GTK_TREE_MODEL (tree_store), &iter);
+        }
+
+      gtk_tree_model_row_inserted (GTK_TREE_MODEL (tree_store), path, &iter);
+
+      if (i == 0 && !had_children && parent_node != priv->root)
+        {
+          GtkTreePath *parent_path = gtk_tree_path_copy (path);
+
+          gtk_tree_path_up (parent_path);
+          gtk_tree_model_row_has_child_toggled (GTK_TREE_MODEL (tree_store), parent_path, parent);
+          gtk_tree_path_free (parent_path);
+        }
+
+      if (!sorted)
+        gtk_tree_path_next (path);
+    }
+
+  gtk_tree_path_free (path);
+
+  validate_tree (tree_store);
+}
+
 /**
  * gtk_tree_store_prepend:
  * @tree_store: A #GtkTreeStore
@@ -42,6 +42,21 @@ typedef struct _GtkTreeStore        GtkTreeStore;
 typedef struct _GtkTreeStoreClass   GtkTreeStoreClass;
 typedef struct _GtkTreeStorePrivate GtkTreeStorePrivate;
 
+/**
+ * GtkTreeStoreFillFunc:
+ * @tree_store: the #GtkTreeStore being filled
+ * @iter: the new row
+ * @index: the index of the row among the rows being inserted
+ * @user_data: (closure): user data passed to gtk_tree_store_insert_rows()
+ *
+ * Sets the values of a row inserted with gtk_tree_store_insert_rows(),
+ * usually by calling gtk_tree_store_set().
+ */
+typedef void (* GtkTreeStoreFillFunc) (GtkTreeStore *tree_store,
+                                       GtkTreeIter  *iter,
+                                       gint          index,
+                                       gpointer      user_data);
+
 struct _GtkTreeStore
 {
   GObject parent;
@@ -128,6 +143,13 @@ void          gtk_tree_store_insert_with_valuesv (GtkTreeStore *tree_store,
 						  GValue       *values,
 						  gint          n_values);
 GDK_AVAILABLE_IN_ALL
+void          gtk_tree_store_insert_rows      (GtkTreeStore         *tree_store,
+                                               GtkTreeIter          *parent,
+                                               gint                  position,
+                                               gint                  n_rows,
+                                               GtkTreeStoreFillFunc  fill_func,
+                                               gpointer              user_data);
+GDK_AVAILABLE_IN_ALL
 void          gtk_tree_store_prepend          (GtkTreeStore *tree_store,
 					       GtkTreeIter  *iter,
 					       GtkTreeIter  *parent);
@@ -5598,12 +5598,10 @@ validate_row (GtkTreeView   *tree_view,
 
       original_width = _gtk_tree_view_column_get_requested_width (column);
 
-      gtk_tree_view_column_cell_set_cell_data (column, tree_view->priv->model, iter,
-					       GTK_TREE_RBNODE_FLAG_SET (node, GTK_TREE_RBNODE_IS_PARENT),
-					       node->children?TRUE:FALSE);
-      gtk_tree_view_column_cell_get_size (column,
-					  NULL, NULL, NULL,
-					  NULL, &row_height);
+      _gtk_tree_view_column_measure_row (column, tree_view->priv->model, iter,
+                                         GTK_TREE_RBNODE_FLAG_SET (node, GTK_TREE_RBNODE_IS_PARENT),
+                                         node->children?TRUE:FALSE,
+                                         &row_height);
 
       if (is_separator)
         {
@@ -8721,23 +8719,33 @@ gtk_tree_view_build_tree (GtkTreeView   *tree_view,
 {
   GtkTreeRBNode *temp = NULL;
   GtkTreePath *path = NULL;
+  gint height;
+  gboolean valid;
 
-  do
+  /* With a fixed height, rows don't need to be validated */
+  valid = tree_view->priv->fixed_height > 0;
+  height = valid ? tree_view->priv->fixed_height : 0;
+
+  if (tree_view->priv->is_list)
     {
-      gtk_tree_model_ref_node (tree_view->priv->model, iter);
-      temp = gtk_tree_rbtree_insert_after (tree, temp, 0, FALSE);
+      guint n_rows = 0;
 
-      if (tree_view->priv->fixed_height > 0)
+      /* Lists have no children, so all rows can be added at once */
+      do
         {
-          if (GTK_TREE_RBNODE_FLAG_SET (temp, GTK_TREE_RBNODE_INVALID))
-	    {
-              gtk_tree_rbtree_node_set_height (tree, temp, tree_view->priv->fixed_height);
-	      gtk_tree_rbtree_node_mark_valid (tree, temp);
-	    }
+          gtk_tree_model_ref_node (tree_view->priv->model, iter);
+          n_rows++;
         }
+      while (gtk_tree_model_iter_next (tree_view->priv->model, iter));
 
-      if (tree_view->priv->is_list)
-        continue;
+      gtk_tree_rbtree_fill (tree, n_rows, height, valid);
+      return;
+    }
+
+  do
+    {
+      gtk_tree_model_ref_node (tree_view->priv->model, iter);
+      temp = gtk_tree_rbtree_insert_after (tree, temp, height, valid);
 
       if (recurse)
 	{
@@ -172,6 +172,11 @@ struct _GtkTreeViewColumnPrivate
   gulong              remove_editable_signal;
   gulong              context_changed_signal;
 
+  /* Row heights by row content, see _gtk_tree_view_column_measure_row() */
+  GHashTable         *size_cache;
+  GArray             *size_cache_columns;
+  guint               size_cache_layout;
+
   /* Flags */
   guint visible             : 1;
   guint resizable           : 1;
@@ -532,6 +537,9 @@ gtk_tree_view_column_finalize (GObject *object)
 
   g_free (priv->title);
 
+  g_clear_pointer (&priv->size_cache, g_hash_table_unref);
+  g_clear_pointer (&priv->size_cache_columns, g_array_unref);
+
   G_OBJECT_CLASS (gtk_tree_view_column_parent_class)->finalize (object);
 }
 
@@ -1324,6 +1332,10 @@ _gtk_tree_view_column_unset_tree_view (GtkTreeViewColumn *column)
   if (priv->tree_view == NULL)
     return;
 
+  /* The sizes depend on the style of the tree view */
+  if (priv->size_cache)
+    g_hash_table_remove_all (priv->size_cache);
+
   gtk_container_remove (GTK_CONTAINER (priv->tree_view), priv->button);
 
   if (priv->property_changed_signal)
@@ -2772,6 +2784,296 @@ gtk_tree_view_column_cell_get_size (GtkTreeViewColumn  *tree_column,
 
 }
 
+/* Rows with the same content have the same size, so for columns that
+ * show values from a small set (flags, enums, repeated strings)
+ * the cells only need to be measured once per value instead of once
+ * per row.
+ */
+#define SIZE_CACHE_MAX_ENTRIES 1024
+
+typedef struct {
+  guint   hash;
+  guint   is_expander : 1;
+  guint   is_expanded : 1;
+  guint   n_values;
+  GValue *values;
+
+  gint    for_width;
+  gint    height;
+} SizeCacheEntry;
+
+static gboolean
+size_cache_value_hash (const GValue *value,
+                       guint        *hash)
+{
+  switch (G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (value)))
+    {
+    case G_TYPE_BOOLEAN:
+      *hash = g_value_get_boolean (value);
+      return TRUE;
+    case G_TYPE_CHAR:
+      *hash = g_value_get_schar (value);
+      return TRUE;
+    case G_TYPE_UCHAR:
+      *hash = g_value_get_uchar (value);
+      return TRUE;
+    case G_TYPE_INT:
+      *hash = g_value_get_int (value);
+      return TRUE;
+    case G_TYPE_UINT:
+      *hash = g_value_get_uint (value);
+      return TRUE;
+    case G_TYPE_LONG:
+      *hash = g_value_get_long (value);
+      return TRUE;
+    case G_TYPE_ULONG:
+      *hash = g_value_get_ulong (value);
+      return TRUE;
+    case G_TYPE_INT64:
+      *hash = g_value_get_int64 (value);
+      return TRUE;
+    case G_TYPE_UINT64:
+      *hash = g_value_get_uint64 (value);
+      return TRUE;
+    case G_TYPE_ENUM:
+      *hash = g_value_get_enum (value);
+      return TRUE;
+    case G_TYPE_FLAGS:
+      *hash = g_value_get_flags (value);
+      return TRUE;
+    case G_TYPE_FLOAT:
+    case G_TYPE_DOUBLE:
+      {
+        gdouble d = G_VALUE_HOLDS_FLOAT (value) ? g_value_get_float (value) : g_value_get_double (value);
+
+        *hash = g_double_hash (&d);
+      }
+      return TRUE;
+    case G_TYPE_STRING:
+      *hash = g_value_get_string (value) ? g_str_hash (g_value_get_string (value)) : 0;
+      return TRUE;
+    default:
+      /* Boxed types are copied by the model, so they never compare equal.
+       * Pointers and objects could only be compared by address, which says
+       * nothing about their content: objects can change without a row
+       * change, and a freed pointer can be reused for a different value. */
+      return FALSE;
+    }
+}
+
+static gboolean
+size_cache_value_equal (const GValue *a,
+                        const GValue *b)
+{
+  if (G_VALUE_TYPE (a) != G_VALUE_TYPE (b))
+    return FALSE;
+
+  switch (G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (a)))
+    {
+    case G_TYPE_BOOLEAN:
+      return g_value_get_boolean (a) == g_value_get_boolean (b);
+    case G_TYPE_CHAR:
+      return g_value_get_schar (a) == g_value_get_schar (b);
+    case G_TYPE_UCHAR:
+      return g_value_get_uchar (a) == g_value_get_uchar (b);
+    case G_TYPE_INT:
+      return g_value_get_int (a) == g_value_get_int (b);
+    case G_TYPE_UINT:
+      return g_value_get_uint (a) == g_value_get_uint (b);
+    case G_TYPE_LONG:
+      return g_value_get_long (a) == g_value_get_long (b);
+    case G_TYPE_ULONG:
+      return g_value_get_ulong (a) == g_value_get_ulong (b);
+    case G_TYPE_INT64:
+      return g_value_get_int64 (a) == g_value_get_int64 (b);
+    case G_TYPE_UINT64:
+      return g_value_get_uint64 (a) == g_value_get_uint64 (b);
+    case G_TYPE_ENUM:
+      return g_value_get_enum (a) == g_value_get_enum (b);
+    case G_TYPE_FLAGS:
+      return g_value_get_flags (a) == g_value_get_flags (b);
+    case G_TYPE_FLOAT:
+      return g_value_get_float (a) == g_value_get_float (b);
+    case G_TYPE_DOUBLE:
+      return g_value_get_double (a) == g_value_get_double (b);
+    case G_TYPE_STRING:
+      return g_strcmp0 (g_value_get_string (a), g_value_get_string (b)) == 0;
+    default:
+      g_assert_not_reached ();
+      return FALSE;
+    }
+}
+
+static guint
+size_cache_entry_hash (gconstpointer data)
+{
+  const SizeCacheEntry *entry = data;
+
+  return entry->hash;
+}
+
+static gboolean
+size_cache_entry_equal (gconstpointer a,
+                        gconstpointer b)
+{
+  const SizeCacheEntry *ea = a;
+  const SizeCacheEntry *eb = b;
+  guint i;
+
+  if (ea->hash != eb->hash ||
+      ea->is_expander != eb->is_expander ||
+      ea->is_expanded != eb->is_expanded ||
+      ea->n_values != eb->n_values)
+    return FALSE;
+
+  for (i = 0; i < ea->n_values; i++)
+    {
+      if (!size_cache_value_equal (&ea->values[i], &eb->values[i]))
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+size_cache_entry_clear (SizeCacheEntry *entry)
+{
+  guint i;
+
+  for (i = 0; i < entry->n_values; i++)
+    g_value_unset (&entry->values[i]);
+  g_free (entry->values);
+}
+
+static void
+size_cache_entry_free (gpointer data)
+{
+  SizeCacheEntry *entry = data;
+
+  size_cache_entry_clear (entry);
+  g_slice_free (SizeCacheEntry, entry);
+}
+
+/* Fills in @entry from the row at @iter.
+ * Returns %FALSE if the row's content can't be used as a cache key. */
+static gboolean
+size_cache_entry_init (SizeCacheEntry *entry,
+                       GtkTreeModel   *model,
+                       GtkTreeIter    *iter,
+                       GArray         *columns,
+                       gboolean        is_expander,
+                       gboolean        is_expanded)
+{
+  guint i;
+
+  entry->hash = (is_expander ? 1 : 0) | (is_expanded ? 2 : 0);
+  entry->is_expander = is_expander;
+  entry->is_expanded = is_expanded;
+  entry->n_values = columns->len;
+  entry->values = g_new0 (GValue, columns->len);
+
+  for (i = 0; i < columns->len; i++)
+    {
+      guint hash;
+
+      gtk_tree_model_get_value (model, iter, g_array_index (columns, gint, i), &entry->values[i]);
+      if (!size_cache_value_hash (&entry->values[i], &hash))
+        {
+          entry->n_values = i + 1;
+          return FALSE;
+        }
+
+      entry->hash = entry->hash * 31 + hash;
+    }
+
+  return TRUE;
+}
+
+/* Like calling gtk_tree_view_column_cell_set_cell_data() followed by
+ * gtk_tree_view_column_cell_get_size() to get the height of a row,
+ * but skips both when a row with the same content was measured before.
+ *
+ * A cached row's width is known to be included in the context already
+ * because the cache is cleared whenever the context is reset, so only
+ * the height needs to be remembered, together with the width it was
+ * measured for. Note that the renderers are not set up for @iter when
+ * the cached value is used.
+ */
+void
+_gtk_tree_view_column_measure_row (GtkTreeViewColumn *tree_column,
+                                   GtkTreeModel      *tree_model,
+                                   GtkTreeIter       *iter,
+                                   gboolean           is_expander,
+                                   gboolean           is_expanded,
+                                   gint              *height)
+{
+  GtkTreeViewColumnPrivate *priv = tree_column->priv;
+  SizeCacheEntry lookup, *entry;
+  guint layout;
+  gint for_width;
+
+  if (priv->size_cache == NULL)
+    {
+      priv->size_cache = g_hash_table_new_full (size_cache_entry_hash,
+                                                size_cache_entry_equal,
+                                                size_cache_entry_free,
+                                                NULL);
+      priv->size_cache_columns = g_array_new (FALSE, FALSE, sizeof (gint));
+    }
+
+  g_array_set_size (priv->size_cache_columns, 0);
+  if (!_gtk_cell_area_get_attribute_columns (priv->cell_area, priv->size_cache_columns, &layout))
+    {
+      gtk_tree_view_column_cell_set_cell_data (tree_column, tree_model, iter, is_expander, is_expanded);
+      gtk_tree_view_column_cell_get_size (tree_column, NULL, NULL, NULL, NULL, height);
+      return;
+    }
+
+  if (layout != priv->size_cache_layout)
+    {
+      g_hash_table_remove_all (priv->size_cache);
+      priv->size_cache_layout = layout;
+    }
+
+  if (!size_cache_entry_init (&lookup, tree_model, iter, priv->size_cache_columns, is_expander, is_expanded))
+    {
+      size_cache_entry_clear (&lookup);
+      gtk_tree_view_column_cell_set_cell_data (tree_column, tree_model, iter, is_expander, is_expanded);
+      gtk_tree_view_column_cell_get_size (tree_column, NULL, NULL, NULL, NULL, height);
+      return;
+    }
+
+  gtk_cell_area_context_get_preferred_width (priv->cell_area_context, &for_width, NULL);
+
+  entry = g_hash_table_lookup (priv->size_cache, &lookup);
+  if (entry && entry->for_width == for_width)
+    {
+      size_cache_entry_clear (&lookup);
+      *height = entry->height;
+      return;
+    }
+
+  gtk_tree_view_column_cell_set_cell_data (tree_column, tree_model, iter, is_expander, is_expanded);
+  gtk_tree_view_column_cell_get_size (tree_column, NULL, NULL, NULL, &for_width, height);
+
+  if (entry)
+    {
+      size_cache_entry_clear (&lookup);
+    }
+  else
+    {
+      /* Rows that are all different would only waste memory */
+      if (g_hash_table_size (priv->size_cache) >= SIZE_CACHE_MAX_ENTRIES)
+        g_hash_table_remove_all (priv->size_cache);
+
+      entry = g_slice_dup (SizeCacheEntry, &lookup);
+      g_hash_table_add (priv->size_cache, entry);
+    }
+
+  entry->for_width = for_width;
+  entry->height = *height;
+}
+
 /**
  * gtk_tree_view_column_cell_snapshot:
  * @tree_column: A #GtkTreeViewColumn.
@@ -2890,6 +3192,12 @@ _gtk_tree_view_column_cell_set_dirty (GtkTreeViewColumn *tree_column,
   priv->padding = 0;
   priv->width = 0;
 
+  /* Cached sizes are only valid for as long as the context has all
+   * the widths of the cached rows, see _gtk_tree_view_column_measure_row()
+   */
+  if (priv->size_cache)
+    g_hash_table_remove_all (priv->size_cache);
+
   /* Issue a manual reset on the context to have all
    * sizes re-requested for the context.
    */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018 Red Hat, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "config.h"
+#include <glib/gi18n-lib.h>
+
+#include "css-profile.h"
+
+#include "gtkcssprofilerprivate.h"
+#include "gtktextbuffer.h"
+#include "gtktextview.h"
+#include "gtktogglebutton.h"
+
+struct _GtkInspectorCssProfilePrivate
+{
+  GtkWidget *record_button;
+  GtkTextBuffer *text;
+  guint update_source_id;
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (GtkInspectorCssProfile, gtk_inspector_css_profile, GTK_TYPE_BOX)
+
+static void
+update_profile (GtkInspectorCssProfile *sl)
+{
+  char *profile;
+
+  profile = gtk_css_profiler_to_string ();
+  gtk_text_buffer_set_text (sl->priv->text, profile, -1);
+  g_free (profile);
+}
+
+static gboolean
+update_profile_cb (gpointer data)
+{
+  update_profile (GTK_INSPECTOR_CSS_PROFILE (data));
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+record_toggled (GtkToggleButton        *button,
+                GtkInspectorCssProfile *sl)
+{
+  gboolean active = gtk_toggle_button_get_active (button);
+
+  gtk_css_profiler_set_enabled (active);
+
+  if (active && sl->priv->update_source_id == 0)
+    {
+      sl->priv->update_source_id = g_timeout_add_seconds (1, update_profile_cb, sl);
+      g_source_set_name_by_id (sl->priv->update_source_id, "[gtk] update_profile_cb");
+    }
+  else if (!active && sl->priv->update_source_id != 0)
+    {
+      g_source_remove (sl->priv->update_source_id);
+      sl->priv->update_source_id = 0;
+    }
+
+  update_profile (sl);
+}
+
+static void
+reset_clicked (GtkWidget              *button,
+               GtkInspectorCssProfile *sl)
+{
+  gtk_css_profiler_reset ();
+  update_profile (sl);
+}
+
+static void
+gtk_inspector_css_profile_init (GtkInspectorCssProfile *sl)
+{
+  sl->priv = gtk_inspector_css_profile_get_instance_private (sl);
+  gtk_widget_init_template (GTK_WIDGET (sl));
+
+  /* Profiling may have been turned on with GTK_CSS_PROFILE */
+  gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (sl->priv->record_button),
+                                gtk_css_profiler_get_enabled ());
+  update_profile (sl);
+}
+
+static void
+finalize (GObject *object)
+{
+  GtkInspectorCssProfile *sl = GTK_INSPECTOR_CSS_PROFILE (object);
+
+  if (sl->priv->update_source_id)
+    g_source_remove (sl->priv->update_source_id);
+
+  G_OBJECT_CLASS (gtk_inspector_css_profile_parent_class)->finalize (object);
+}
+
+static void
+gtk_inspector_css_profile_class_init (GtkInspectorCssProfileClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
+
+  object_class->finalize = finalize;
+
+  gtk_widget_class_set_template_from_resource (widget_class, "/org/gtk/libgtk/inspector/css-profile.ui");
+  gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorCssProfile, record_button);
+  gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorCssProfile, text);
+  gtk_widget_class_bind_template_callback (widget_class, record_toggled);
+  gtk_widget_class_bind_template_callback (widget_class, reset_clicked);
+}
+
+// vim: set et sw=2 ts=2:
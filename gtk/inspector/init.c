@@ -29,6 +29,7 @@
 #include "controllers.h"
 #include "css-editor.h"
 #include "css-node-tree.h"
+#include "css-profile.h"
 #include "data-list.h"
 #include "general.h"
 #include "graphdata.h"
@@ -66,6 +67,7 @@ gtk_inspector_init (void)
   g_type_ensure (GTK_TYPE_INSPECTOR_CONTROLLERS);
   g_type_ensure (GTK_TYPE_INSPECTOR_CSS_EDITOR);
   g_type_ensure (GTK_TYPE_INSPECTOR_CSS_NODE_TREE);
+  g_type_ensure (GTK_TYPE_INSPECTOR_CSS_PROFILE);
   g_type_ensure (GTK_TYPE_INSPECTOR_DATA_LIST);
   g_type_ensure (GTK_TYPE_INSPECTOR_GENERAL);
   g_type_ensure (GTK_TYPE_INSPECTOR_LOGS);
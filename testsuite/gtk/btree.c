@@ -0,0 +1,345 @@
+/* GtkBTree tests.
+ *
+ * Copyright (C) 2018, Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <locale.h>
+
+#include <gtk/gtk.h>
+
+#include "gtk/gtkbtreeprivate.h"
+#include "gtk/gtkrbtreeprivate.h"
+
+typedef struct _Node Node;
+typedef struct _Aug Aug;
+
+struct _Node {
+  guint value;
+};
+
+struct _Aug {
+  guint n_items;
+  guint64 sum;
+};
+
+static void
+augment (GtkBTree *tree,
+         gpointer  _aug,
+         gpointer  _nodes,
+         guint     n_nodes)
+{
+  Aug *aug = _aug;
+  Node *nodes = _nodes;
+  guint i;
+
+  aug->n_items = n_nodes;
+  aug->sum = 0;
+  for (i = 0; i < n_nodes; i++)
+    aug->sum += nodes[i].value;
+}
+
+static void
+combine (GtkBTree *tree,
+         gpointer  _aug,
+         gpointer  _augs,
+         guint     n_augs)
+{
+  Aug *aug = _aug;
+  Aug *augs = _augs;
+  guint i;
+
+  aug->n_items = 0;
+  aug->sum = 0;
+  for (i = 0; i < n_augs; i++)
+    {
+      aug->n_items += augs[i].n_items;
+      aug->sum += augs[i].sum;
+    }
+}
+
+/* finds the first element where the running sum exceeds *user_data */
+static gboolean
+find_sum (GtkBTree *tree,
+          gpointer  _aug,
+          gpointer  _node,
+          gpointer  user_data)
+{
+  Aug *aug = _aug;
+  Node *node = _node;
+  guint64 *sum = user_data;
+  guint64 value;
+
+  value = aug ? aug->sum : node->value;
+  if (*sum < value)
+    return TRUE;
+
+  *sum -= value;
+  return FALSE;
+}
+
+static void
+assert_tree_equal (GtkBTree *tree,
+                   GArray   *array)
+{
+  Aug *aug;
+  guint64 sum;
+  guint i;
+
+  g_assert_cmpuint (gtk_btree_get_size (tree), ==, array->len);
+
+  sum = 0;
+  for (i = 0; i < array->len; i++)
+    {
+      Node *node = gtk_btree_get (tree, i);
+
+      g_assert_cmpuint (node->value, ==, g_array_index (array, guint, i));
+      sum += node->value;
+    }
+
+  aug = gtk_btree_get_augment (tree);
+  if (array->len == 0)
+    {
+      g_assert_null (aug);
+      return;
+    }
+
+  g_assert_nonnull (aug);
+  g_assert_cmpuint (aug->n_items, ==, array->len);
+  g_assert_cmpuint (aug->sum, ==, sum);
+}
+
+static void
+test_create (void)
+{
+  GtkBTree *tree;
+  Node *node;
+  guint i;
+
+  tree = gtk_btree_new (Node, Aug, augment, combine, NULL);
+  g_assert_cmpuint (gtk_btree_get_size (tree), ==, 0);
+  g_assert_null (gtk_btree_get_augment (tree));
+
+  node = gtk_btree_insert (tree, 0, 1000);
+  g_assert_nonnull (node);
+  g_assert_cmpuint (node->value, ==, 0);
+  g_assert_cmpuint (gtk_btree_get_size (tree), ==, 1000);
+
+  for (i = 0; i < 1000; i++)
+    {
+      node = gtk_btree_get (tree, i);
+      g_assert_cmpuint (node->value, ==, 0);
+      node->value = i;
+      gtk_btree_mark_dirty (tree, i);
+    }
+  g_assert_cmpuint (((Aug *) gtk_btree_get_augment (tree))->sum, ==, 999 * 1000 / 2);
+
+  gtk_btree_remove_all (tree);
+  g_assert_cmpuint (gtk_btree_get_size (tree), ==, 0);
+  g_assert_null (gtk_btree_get_augment (tree));
+
+  gtk_btree_unref (tree);
+}
+
+static void
+test_random (void)
+{
+  GtkBTree *tree;
+  GArray *array;
+  guint step, i, counter;
+
+  tree = gtk_btree_new (Node, Aug, augment, combine, NULL);
+  array = g_array_new (FALSE, FALSE, sizeof (guint));
+  counter = 1;
+
+  for (step = 0; step < 1000; step++)
+    {
+      guint pos = g_test_rand_int_range (0, array->len + 1);
+      guint n;
+
+      switch (g_test_rand_int_range (0, 4))
+        {
+        case 0:
+        case 1:
+          n = g_test_rand_bit () ? g_test_rand_int_range (0, 5) : g_test_rand_int_range (0, 500);
+          gtk_btree_insert (tree, pos, n);
+          for (i = 0; i < n; i++)
+            {
+              Node *node = gtk_btree_get (tree, pos + i);
+
+              node->value = counter;
+              gtk_btree_mark_dirty (tree, pos + i);
+              g_array_insert_val (array, pos + i, counter);
+              counter++;
+            }
+          break;
+
+        case 2:
+          n = g_test_rand_int_range (0, MIN (array->len - pos, 1000) + 1);
+          gtk_btree_remove (tree, pos, n);
+          g_array_remove_range (array, pos, n);
+          break;
+
+        case 3:
+          if (pos < array->len)
+            {
+              guint64 sum;
+
+              ((Node *) gtk_btree_get (tree, pos))->value = counter;
+              gtk_btree_mark_dirty (tree, pos);
+              g_array_index (array, guint, pos) = counter;
+              counter++;
+
+              sum = 0;
+              for (i = 0; i < pos; i++)
+                sum += g_array_index (array, guint, i);
+              g_assert_cmpuint (gtk_btree_find (tree, find_sum, &sum), ==, pos);
+              g_assert_cmpuint (sum, ==, 0);
+            }
+          break;
+
+        default:
+          g_assert_not_reached ();
+        }
+
+      assert_tree_equal (tree, array);
+    }
+
+  gtk_btree_remove (tree, 0, array->len);
+  g_array_set_size (array, 0);
+  assert_tree_equal (tree, array);
+
+  g_array_unref (array);
+  gtk_btree_unref (tree);
+}
+
+typedef struct _RbNode RbNode;
+typedef struct _RbAug RbAug;
+
+struct _RbNode {
+  guint value;
+};
+
+struct _RbAug {
+  guint n_items;
+};
+
+static void
+rb_augment (GtkRbTree *tree,
+            gpointer   _aug,
+            gpointer   _node,
+            gpointer   left,
+            gpointer   right)
+{
+  RbAug *aug = _aug;
+
+  aug->n_items = 1;
+
+  if (left)
+    aug->n_items += ((RbAug *) gtk_rb_tree_get_augment (tree, left))->n_items;
+  if (right)
+    aug->n_items += ((RbAug *) gtk_rb_tree_get_augment (tree, right))->n_items;
+}
+
+static RbNode *
+rb_get (GtkRbTree *tree,
+        guint      pos)
+{
+  RbNode *node, *tmp;
+
+  node = gtk_rb_tree_get_root (tree);
+
+  while (node)
+    {
+      tmp = gtk_rb_tree_node_get_left (node);
+      if (tmp)
+        {
+          RbAug *aug = gtk_rb_tree_get_augment (tree, tmp);
+          if (pos < aug->n_items)
+            {
+              node = tmp;
+              continue;
+            }
+          pos -= aug->n_items;
+        }
+
+      if (pos < 1)
+        break;
+      pos--;
+
+      node = gtk_rb_tree_node_get_right (node);
+    }
+
+  return node;
+}
+
+static void
+test_lookup (void)
+{
+  guint n = g_test_perf () ? 1000000 : 1000;
+  guint n_lookups = 10 * n;
+  GtkBTree *btree;
+  GtkRbTree *rbtree;
+  guint *positions;
+  double elapsed;
+  guint i, sum;
+
+  positions = g_new (guint, n_lookups);
+  for (i = 0; i < n_lookups; i++)
+    positions[i] = g_test_rand_int_range (0, n);
+
+  btree = gtk_btree_new (Node, Aug, augment, combine, NULL);
+  gtk_btree_insert (btree, 0, n);
+  for (i = 0; i < n; i++)
+    ((Node *) gtk_btree_get (btree, i))->value = i;
+
+  rbtree = gtk_rb_tree_new (RbNode, RbAug, rb_augment, NULL, NULL);
+  for (i = 0; i < n; i++)
+    ((RbNode *) gtk_rb_tree_insert_before (rbtree, NULL))->value = i;
+
+  g_test_timer_start ();
+  sum = 0;
+  for (i = 0; i < n_lookups; i++)
+    sum += ((Node *) gtk_btree_get (btree, positions[i]))->value;
+  elapsed = g_test_timer_elapsed ();
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "%u lookups in btree with %u items: %gsec", n_lookups, n, elapsed);
+
+  g_test_timer_start ();
+  for (i = 0; i < n_lookups; i++)
+    sum -= rb_get (rbtree, positions[i])->value;
+  elapsed = g_test_timer_elapsed ();
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "%u lookups in rbtree with %u items: %gsec", n_lookups, n, elapsed);
+
+  g_assert_cmpuint (sum, ==, 0);
+
+  gtk_rb_tree_unref (rbtree);
+  gtk_btree_unref (btree);
+  g_free (positions);
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  setlocale (LC_ALL, "C");
+
+  g_test_add_func ("/btree/create", test_create);
+  g_test_add_func ("/btree/random", test_random);
+  g_test_add_func ("/btree/lookup", test_lookup);
+
+  return g_test_run ();
+}
@@ -1,4 +1,5 @@
 #include <gtk/gtk.h>
+#include <string.h>
 
 static void
 assert_section_is_not_null (GtkCssProvider *provider,
@@ -33,6 +34,146 @@ test_section_load_nonexisting_file (void)
   g_object_unref (provider);
 }
 
+static void
+test_add_remove_rules (void)
+{
+  GtkCssProvider *provider;
+  guint id1, id2;
+  char *str;
+
+  provider = gtk_css_provider_new ();
+  gtk_css_provider_load_from_data (provider, "label { color: red; }", -1);
+
+  id1 = gtk_css_provider_add_rules (provider, "button { color: blue; }", -1);
+  id2 = gtk_css_provider_add_rules (provider, "entry { color: green; }", -1);
+  g_assert_cmpuint (id1, !=, 0);
+  g_assert_cmpuint (id2, !=, 0);
+  g_assert_cmpuint (id1, !=, id2);
+
+  str = gtk_css_provider_to_string (provider);
+  g_assert (strstr (str, "label") != NULL);
+  g_assert (strstr (str, "button") != NULL);
+  g_assert (strstr (str, "entry") != NULL);
+  g_free (str);
+
+  gtk_css_provider_remove_rules (provider, id1);
+
+  str = gtk_css_provider_to_string (provider);
+  g_assert (strstr (str, "label") != NULL);
+  g_assert (strstr (str, "button") == NULL);
+  g_assert (strstr (str, "entry") != NULL);
+  g_free (str);
+
+  /* reloading drops all added rules */
+  gtk_css_provider_load_from_data (provider, "label { color: red; }", -1);
+  gtk_css_provider_remove_rules (provider, id2);
+
+  str = gtk_css_provider_to_string (provider);
+  g_assert (strstr (str, "entry") == NULL);
+  g_free (str);
+
+  g_object_unref (provider);
+}
+
+static GtkStyleContext *
+create_context (GType             type,
+                const char       *name,
+                GtkStyleProvider *provider)
+{
+  GtkStyleContext *context;
+  GtkWidgetPath *path;
+
+  context = gtk_style_context_new ();
+
+  path = gtk_widget_path_new ();
+  gtk_widget_path_append_type (path, GTK_TYPE_WINDOW);
+  gtk_widget_path_iter_set_object_name (path, 0, "window");
+  gtk_widget_path_append_type (path, type);
+  gtk_widget_path_iter_set_object_name (path, 1, name);
+  gtk_style_context_set_path (context, path);
+  gtk_widget_path_free (path);
+
+  gtk_style_context_add_provider (context, provider, GTK_STYLE_PROVIDER_PRIORITY_USER);
+
+  return context;
+}
+
+static void
+count_changes (GtkStyleContext *context,
+               guint           *n_changes)
+{
+  (*n_changes)++;
+}
+
+static void
+assert_color (GtkStyleContext *context,
+              const char      *expected)
+{
+  GdkRGBA color, expected_color;
+
+  gdk_rgba_parse (&expected_color, expected);
+  gtk_style_context_get_color (context, &color);
+  g_assert (gdk_rgba_equal (&color, &expected_color));
+}
+
+static void
+test_add_remove_rules_style (void)
+{
+  GtkCssProvider *provider;
+  GtkStyleContext *label_context, *button_context;
+  guint label_changes, button_changes;
+  guint id1, id2;
+
+  provider = gtk_css_provider_new ();
+  gtk_css_provider_load_from_data (provider,
+                                   "label { color: red; }\n"
+                                   "button { color: red; }",
+                                   -1);
+
+  label_context = create_context (GTK_TYPE_LABEL, "label", GTK_STYLE_PROVIDER (provider));
+  button_context = create_context (GTK_TYPE_BUTTON, "button", GTK_STYLE_PROVIDER (provider));
+  assert_color (label_context, "red");
+  assert_color (button_context, "red");
+
+  label_changes = button_changes = 0;
+  g_signal_connect (label_context, "changed", G_CALLBACK (count_changes), &label_changes);
+  g_signal_connect (button_context, "changed", G_CALLBACK (count_changes), &button_changes);
+
+  /* added rules win over loaded ones of the same specificity... */
+  id1 = gtk_css_provider_add_rules (provider, "button { color: blue; }", -1);
+  assert_color (label_context, "red");
+  assert_color (button_context, "blue");
+
+  /* ...and only the nodes they can match get invalidated */
+  g_assert_cmpuint (label_changes, ==, 0);
+  g_assert_cmpuint (button_changes, >, 0);
+
+  /* but not over more specific ones */
+  id2 = gtk_css_provider_add_rules (provider, "* { color: green; }", -1);
+  assert_color (label_context, "red");
+  assert_color (button_context, "blue");
+
+  /* later added rules win over earlier added ones */
+  gtk_css_provider_remove_rules (provider, id2);
+  id2 = gtk_css_provider_add_rules (provider, "button { color: green; }", -1);
+  assert_color (button_context, "green");
+
+  /* removing them restores the previous value */
+  gtk_css_provider_remove_rules (provider, id2);
+  assert_color (button_context, "blue");
+
+  label_changes = button_changes = 0;
+  gtk_css_provider_remove_rules (provider, id1);
+  assert_color (label_context, "red");
+  assert_color (button_context, "red");
+  g_assert_cmpuint (label_changes, ==, 0);
+  g_assert_cmpuint (button_changes, >, 0);
+
+  g_object_unref (label_context);
+  g_object_unref (button_context);
+  g_object_unref (provider);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -41,6 +182,8 @@ main (int argc, char *argv[])
 
   g_test_add_func ("/cssprovider/section-in-load-from-data", test_section_in_load_from_data);
   g_test_add_func ("/cssprovider/load-nonexisting-file", test_section_load_nonexisting_file);
+  g_test_add_func ("/cssprovider/add-remove-rules", test_add_remove_rules);
+  g_test_add_func ("/cssprovider/add-remove-rules-style", test_add_remove_rules_style);
 
   return g_test_run ();
 }
@@ -306,6 +306,42 @@ test_delete (void)
   g_object_unref (entry);
 }
 
+static void
+test_buffer_offsets (void)
+{
+  GtkEntryBuffer *buffer;
+
+  buffer = gtk_entry_buffer_new ("abcdef", -1);
+
+  gtk_entry_buffer_insert_text (buffer, 3, "XY", -1);
+  g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, "abcXYdef");
+
+  gtk_entry_buffer_delete_text (buffer, 1, 2);
+  g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, "aXYdef");
+
+  /* Offsets are in characters once the text is not ASCII anymore */
+  gtk_entry_buffer_insert_text (buffer, 1, "\303\244\303\266", -1);
+  g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, "a\303\244\303\266XYdef");
+  g_assert_cmpuint (gtk_entry_buffer_get_length (buffer), ==, 8);
+  g_assert_cmpuint (gtk_entry_buffer_get_bytes (buffer), ==, 10);
+
+  gtk_entry_buffer_insert_text (buffer, 4, "-", -1);
+  g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, "a\303\244\303\266X-Ydef");
+
+  gtk_entry_buffer_delete_text (buffer, 2, 3);
+  g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, "a\303\244Ydef");
+
+  gtk_entry_buffer_delete_text (buffer, 1, 1);
+  g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, "aYdef");
+  g_assert_cmpuint (gtk_entry_buffer_get_length (buffer), ==, 5);
+  g_assert_cmpuint (gtk_entry_buffer_get_bytes (buffer), ==, 5);
+
+  gtk_entry_buffer_delete_text (buffer, 3, -1);
+  g_assert_cmpstr (gtk_entry_buffer_get_text (buffer), ==, "aYd");
+
+  g_object_unref (buffer);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -314,6 +350,7 @@ main (int   argc,
 
   g_test_add_func ("/entry/delete", test_delete);
   g_test_add_func ("/entry/insert", test_insert);
+  g_test_add_func ("/entry/buffer-offsets", test_buffer_offsets);
 
   return g_test_run();
 }
@@ -190,6 +190,13 @@ is_not_near (gpointer item,
   return ABS (GPOINTER_TO_INT (g_object_get_qdata (item, number_quark)) - GPOINTER_TO_INT (data)) > 2;
 }
 
+static gboolean
+is_multiple_of (gpointer item,
+                gpointer data)
+{
+  return GPOINTER_TO_UINT (g_object_get_qdata (item, number_quark)) % GPOINTER_TO_UINT (data) == 0;
+}
+
 static void
 test_create (void)
 {
@@ -306,6 +313,82 @@ test_change_filter_func (void)
   g_object_unref (filter);
 }
 
+static void
+test_large (void)
+{
+  GtkFilterListModel *filter;
+  GListStore *store;
+  GPtrArray *items;
+  guint i;
+
+  store = new_store (1, 2000, 1);
+  filter = gtk_filter_list_model_new (G_LIST_MODEL (store), is_multiple_of, GUINT_TO_POINTER (3), NULL);
+  g_assert_cmpint (g_list_model_get_n_items (G_LIST_MODEL (filter)), ==, 666);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 0), ==, 3);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 665), ==, 1998);
+
+  /* remove 701 to 800 */
+  g_list_store_splice (store, 700, 100, NULL, 0);
+  g_assert_cmpint (g_list_model_get_n_items (G_LIST_MODEL (filter)), ==, 633);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 232), ==, 699);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 233), ==, 801);
+
+  /* insert 3001 to 4500 after 10 */
+  items = g_ptr_array_new_with_free_func (g_object_unref);
+  for (i = 3001; i <= 4500; i++)
+    {
+      GObject *object = g_object_new (G_TYPE_OBJECT, NULL);
+      g_object_set_qdata (object, number_quark, GUINT_TO_POINTER (i));
+      g_ptr_array_add (items, object);
+    }
+  g_list_store_splice (store, 10, 0, items->pdata, items->len);
+  g_ptr_array_unref (items);
+  g_assert_cmpint (g_list_model_get_n_items (G_LIST_MODEL (filter)), ==, 1133);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 2), ==, 9);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 3), ==, 3003);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 502), ==, 4500);
+  g_assert_cmpint (get (G_LIST_MODEL (filter), 503), ==, 12);
+
+  gtk_filter_list_model_set_filter_func (filter, is_multiple_of, GUINT_TO_POINTER (1000), NULL);
+  assert_model (filter, "4000 1000 2000");
+
+  g_object_unref (filter);
+  g_object_unref (store);
+}
+
+static void
+test_incremental (void)
+{
+  GtkFilterListModel *filter;
+  GListStore *store;
+
+  store = new_store (1, 10000, 1);
+  filter = gtk_filter_list_model_new (G_LIST_MODEL (store), NULL, NULL, NULL);
+  gtk_filter_list_model_set_incremental (filter, TRUE);
+  g_assert_true (gtk_filter_list_model_get_incremental (filter));
+  g_assert_cmpint (gtk_filter_list_model_get_pending (filter), ==, 0);
+
+  gtk_filter_list_model_set_filter_func (filter, is_multiple_of, GUINT_TO_POINTER (1000), NULL);
+  g_assert_cmpint (gtk_filter_list_model_get_pending (filter), ==, 10000);
+
+  /* changes to the model while filtering must not get lost */
+  g_list_store_splice (store, 9000, 1000, NULL, 0);
+  g_assert_cmpint (gtk_filter_list_model_get_pending (filter), ==, 9000);
+
+  while (gtk_filter_list_model_get_pending (filter) > 0)
+    g_main_context_iteration (NULL, TRUE);
+  assert_model (filter, "1000 2000 3000 4000 5000 6000 7000 8000 9000");
+
+  gtk_filter_list_model_set_filter_func (filter, is_multiple_of, GUINT_TO_POINTER (2000), NULL);
+  g_assert_cmpint (gtk_filter_list_model_get_pending (filter), >, 0);
+  gtk_filter_list_model_set_incremental (filter, FALSE);
+  g_assert_cmpint (gtk_filter_list_model_get_pending (filter), ==, 0);
+  assert_model (filter, "2000 4000 6000 8000");
+
+  g_object_unref (filter);
+  g_object_unref (store);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -319,6 +402,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/filterlistmodel/create", test_create);
   g_test_add_func ("/filterlistmodel/empty_set_filter_func", test_empty_set_filter_func);
   g_test_add_func ("/filterlistmodel/change_filter_func", test_change_filter_func);
+  g_test_add_func ("/filterlistmodel/large", test_large);
+  g_test_add_func ("/filterlistmodel/incremental", test_incremental);
 
   return g_test_run ();
 }
@@ -0,0 +1,206 @@
+#include <gtk/gtk.h>
+
+static GtkWidget *
+create_widget (gpointer item,
+               gpointer data)
+{
+  GtkWidget *label;
+  gint *count = data;
+  gint i;
+  gchar *s;
+
+  count[0]++;
+
+  i = GPOINTER_TO_INT (g_object_get_data (item, "data"));
+  s = g_strdup_printf ("%d", i);
+  label = gtk_label_new (s);
+  g_object_set_data (G_OBJECT (label), "data", GINT_TO_POINTER (i));
+  g_free (s);
+
+  return label;
+}
+
+static void
+bind_child (GtkFlowBoxChild *child,
+            gpointer         item,
+            gpointer         data)
+{
+  GtkWidget *label;
+  gint *count = data;
+  gint i;
+  gchar *s;
+
+  count[1]++;
+
+  label = gtk_bin_get_child (GTK_BIN (child));
+  i = GPOINTER_TO_INT (g_object_get_data (item, "data"));
+  s = g_strdup_printf ("%d", i);
+  gtk_label_set_text (GTK_LABEL (label), s);
+  g_object_set_data (G_OBJECT (label), "data", GINT_TO_POINTER (i));
+  g_free (s);
+}
+
+/* Checks that the children represent consecutive items of @model
+ * and that only the child for @selected is selected, if it exists */
+static guint
+check_bound_children (GtkFlowBox *box,
+                      GListModel *model,
+                      gint        selected)
+{
+  GList *children, *l;
+  guint n_children;
+  gint last;
+
+  n_children = 0;
+  last = -1;
+  children = gtk_container_get_children (GTK_CONTAINER (box));
+  for (l = children; l; l = l->next)
+    {
+      GtkFlowBoxChild *child = l->data;
+      GtkWidget *label = gtk_bin_get_child (GTK_BIN (child));
+      gint index = gtk_flow_box_child_get_index (child);
+      gboolean is_selected = index == selected;
+      GObject *item;
+
+      /* bound children start at the beginning of a line */
+      if (last >= 0)
+        g_assert_cmpint (index, ==, last + 1);
+      else
+        g_assert_cmpint (index % 4, ==, 0);
+      last = index;
+
+      g_assert (gtk_flow_box_get_child_at_index (box, index) == child);
+      item = g_list_model_get_item (model, index);
+      g_assert_cmpint (GPOINTER_TO_INT (g_object_get_data (G_OBJECT (label), "data")), ==,
+                       GPOINTER_TO_INT (g_object_get_data (item, "data")));
+      g_object_unref (item);
+
+      g_assert_cmpint (gtk_flow_box_child_is_selected (child), ==, is_selected);
+      g_assert_cmpint ((gtk_widget_get_state_flags (GTK_WIDGET (child)) & GTK_STATE_FLAG_SELECTED) != 0, ==, is_selected);
+
+      n_children++;
+    }
+  g_list_free (children);
+
+  return n_children;
+}
+
+static void
+count_selection_changes (GtkFlowBox *box,
+                         gint       *count)
+{
+  (*count)++;
+}
+
+static void
+test_bind_model_virtual (void)
+{
+  GtkFlowBox *box;
+  GListStore *store;
+  GtkAdjustment *adjustment;
+  GObject *item;
+  GList *selected;
+  gint count[2] = { 0, 0 };
+  gint selection_changes = 0;
+  guint n_children;
+  gint i;
+
+  store = g_list_store_new (G_TYPE_OBJECT);
+  for (i = 0; i < 10000; i++)
+    {
+      item = g_object_new (G_TYPE_OBJECT, NULL);
+      g_object_set_data (item, "data", GINT_TO_POINTER (i));
+      g_list_store_append (store, item);
+      g_object_unref (item);
+    }
+
+  box = GTK_FLOW_BOX (gtk_flow_box_new ());
+  g_object_ref_sink (box);
+  gtk_widget_show (GTK_WIDGET (box));
+
+  /* make the lines independent of the allocation */
+  gtk_flow_box_set_min_children_per_line (box, 4);
+  gtk_flow_box_set_max_children_per_line (box, 4);
+
+  adjustment = gtk_adjustment_new (0, 0, 1000000, 10, 100, 100);
+  gtk_flow_box_set_vadjustment (box, adjustment);
+
+  gtk_flow_box_bind_model_virtual (box, G_LIST_MODEL (store), create_widget, bind_child, count, NULL);
+  while (g_main_context_iteration (NULL, FALSE));
+
+  n_children = check_bound_children (box, G_LIST_MODEL (store), -1);
+  g_assert_cmpuint (n_children, >, 0);
+  g_assert_cmpuint (n_children, <, 1000);
+  g_assert (gtk_flow_box_get_child_at_index (box, 0) != NULL);
+  g_assert (gtk_flow_box_get_child_at_index (box, 9999) == NULL);
+  g_assert_cmpint (count[0], ==, n_children);
+  g_assert_cmpint (count[1], ==, 0);
+
+  gtk_flow_box_select_child (box, gtk_flow_box_get_child_at_index (box, 2));
+  check_bound_children (box, G_LIST_MODEL (store), 2);
+  g_signal_connect (box, "selected-children-changed",
+                    G_CALLBACK (count_selection_changes), &selection_changes);
+
+  /* scrolling reuses the existing children without selecting them, and
+   * without signals for the selected item losing its child */
+  gtk_adjustment_set_value (adjustment, 5000);
+  while (g_main_context_iteration (NULL, FALSE));
+
+  g_assert_cmpuint (check_bound_children (box, G_LIST_MODEL (store), 2), <, 1000);
+  g_assert (gtk_flow_box_get_child_at_index (box, 0) == NULL);
+  g_assert_cmpint (count[0], <, 2 * n_children);
+  g_assert_cmpint (count[1], >, 0);
+  g_assert_cmpint (selection_changes, ==, 0);
+
+  /* changes inside and outside of the children */
+  g_list_store_remove (store, 0);
+  g_list_store_splice (store, 1000, 5000, NULL, 0);
+  while (g_main_context_iteration (NULL, FALSE));
+  check_bound_children (box, G_LIST_MODEL (store), 1);
+
+  /* scrolling back restores the selection of the item */
+  gtk_adjustment_set_value (adjustment, 0);
+  while (g_main_context_iteration (NULL, FALSE));
+  check_bound_children (box, G_LIST_MODEL (store), 1);
+  g_assert (gtk_flow_box_get_child_at_index (box, 0) != NULL);
+  selected = gtk_flow_box_get_selected_children (box);
+  g_assert_cmpuint (g_list_length (selected), ==, 1);
+  g_assert (selected->data == gtk_flow_box_get_child_at_index (box, 1));
+  g_list_free (selected);
+  g_assert_cmpint (selection_changes, ==, 0);
+
+  /* inserting in front of the selected child moves its selection along */
+  item = g_object_new (G_TYPE_OBJECT, NULL);
+  g_object_set_data (item, "data", GINT_TO_POINTER (-1));
+  g_list_store_insert (store, 0, item);
+  g_object_unref (item);
+  while (g_main_context_iteration (NULL, FALSE));
+  check_bound_children (box, G_LIST_MODEL (store), 2);
+  g_assert_cmpint (selection_changes, ==, 0);
+
+  /* removing the selected item while it has no child changes the selection */
+  gtk_adjustment_set_value (adjustment, 5000);
+  while (g_main_context_iteration (NULL, FALSE));
+  g_list_store_remove (store, 2);
+  g_assert_cmpint (selection_changes, ==, 1);
+  gtk_adjustment_set_value (adjustment, 0);
+  while (g_main_context_iteration (NULL, FALSE));
+  check_bound_children (box, G_LIST_MODEL (store), -1);
+  g_assert_null (gtk_flow_box_get_selected_children (box));
+
+  gtk_flow_box_bind_model (box, NULL, NULL, NULL, NULL);
+  g_assert_cmpuint (check_bound_children (box, G_LIST_MODEL (store), -1), ==, 0);
+
+  g_object_unref (box);
+  g_object_unref (store);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv);
+
+  g_test_add_func ("/flowbox/bind-model-virtual", test_bind_model_virtual);
+
+  return g_test_run ();
+}
@@ -434,6 +434,194 @@ test_header (void)
   g_object_unref (list);
 }
 
+static GtkWidget *
+create_widget (gpointer item,
+               gpointer data)
+{
+  GtkWidget *label;
+  gint *count = data;
+  gint i;
+  gchar *s;
+
+  count[0]++;
+
+  i = GPOINTER_TO_INT (g_object_get_data (item, "data"));
+  s = g_strdup_printf ("%d", i);
+  label = gtk_label_new (s);
+  g_object_set_data (G_OBJECT (label), "data", GINT_TO_POINTER (i));
+  g_free (s);
+
+  return label;
+}
+
+static void
+bind_row (GtkListBoxRow *row,
+          gpointer       item,
+          gpointer       data)
+{
+  GtkWidget *label;
+  gint *count = data;
+  gint i;
+  gchar *s;
+
+  count[1]++;
+
+  label = gtk_bin_get_child (GTK_BIN (row));
+  i = GPOINTER_TO_INT (g_object_get_data (item, "data"));
+  s = g_strdup_printf ("%d", i);
+  gtk_label_set_text (GTK_LABEL (label), s);
+  g_object_set_data (G_OBJECT (label), "data", GINT_TO_POINTER (i));
+  g_free (s);
+}
+
+static guint
+check_bound_rows (GtkListBox *list,
+                  GListModel *model)
+{
+  GList *children, *l;
+  guint n_rows;
+  gint last;
+
+  n_rows = 0;
+  last = -1;
+  children = gtk_container_get_children (GTK_CONTAINER (list));
+  for (l = children; l; l = l->next)
+    {
+      GtkListBoxRow *row = l->data;
+      GtkWidget *label = gtk_bin_get_child (GTK_BIN (row));
+      gint index = gtk_list_box_row_get_index (row);
+      GObject *item;
+
+      if (last >= 0)
+        g_assert_cmpint (index, ==, last + 1);
+      last = index;
+
+      g_assert (gtk_list_box_get_row_at_index (list, index) == row);
+      item = g_list_model_get_item (model, index);
+      g_assert_cmpint (GPOINTER_TO_INT (g_object_get_data (G_OBJECT (label), "data")), ==,
+                       GPOINTER_TO_INT (g_object_get_data (item, "data")));
+      g_object_unref (item);
+      n_rows++;
+    }
+  g_list_free (children);
+
+  return n_rows;
+}
+
+/* Checks that only the row for @selected is selected, if it exists */
+static void
+check_selected_row (GtkListBox *list,
+                    gint        selected)
+{
+  GList *children, *l;
+
+  children = gtk_container_get_children (GTK_CONTAINER (list));
+  for (l = children; l; l = l->next)
+    {
+      GtkListBoxRow *row = l->data;
+      gboolean is_selected = gtk_list_box_row_get_index (row) == selected;
+
+      g_assert_cmpint (gtk_list_box_row_is_selected (row), ==, is_selected);
+      g_assert_cmpint ((gtk_widget_get_state_flags (GTK_WIDGET (row)) & GTK_STATE_FLAG_SELECTED) != 0, ==, is_selected);
+    }
+  g_list_free (children);
+}
+
+static void
+count_selection_changes (GtkListBox *list,
+                         gint       *count)
+{
+  (*count)++;
+}
+
+static void
+test_bind_model_virtual (void)
+{
+  GtkListBox *list;
+  GListStore *store;
+  GtkAdjustment *adjustment;
+  gint count[2] = { 0, 0 };
+  gint selection_changes = 0;
+  guint n_rows;
+  gint i;
+
+  store = g_list_store_new (G_TYPE_OBJECT);
+  for (i = 0; i < 10000; i++)
+    {
+      GObject *item = g_object_new (G_TYPE_OBJECT, NULL);
+
+      g_object_set_data (item, "data", GINT_TO_POINTER (i));
+      g_list_store_append (store, item);
+      g_object_unref (item);
+    }
+
+  list = GTK_LIST_BOX (gtk_list_box_new ());
+  g_object_ref_sink (list);
+  gtk_widget_show (GTK_WIDGET (list));
+
+  adjustment = gtk_adjustment_new (0, 0, 1000000, 10, 100, 100);
+  gtk_list_box_set_adjustment (list, adjustment);
+
+  gtk_list_box_bind_model_virtual (list, G_LIST_MODEL (store), create_widget, bind_row, count, NULL);
+  while (g_main_context_iteration (NULL, FALSE));
+
+  n_rows = check_bound_rows (list, G_LIST_MODEL (store));
+  g_assert_cmpuint (n_rows, >, 0);
+  g_assert_cmpuint (n_rows, <, 1000);
+  g_assert (gtk_list_box_get_row_at_index (list, 0) != NULL);
+  g_assert (gtk_list_box_get_row_at_index (list, 9999) == NULL);
+  g_assert_cmpint (count[0], ==, n_rows);
+  g_assert_cmpint (count[1], ==, 0);
+
+  gtk_list_box_select_row (list, gtk_list_box_get_row_at_index (list, 2));
+  check_selected_row (list, 2);
+  g_signal_connect (list, "selected-rows-changed",
+                    G_CALLBACK (count_selection_changes), &selection_changes);
+
+  /* scrolling reuses the existing rows without selecting them, and
+   * without signals for the selected item losing its row */
+  gtk_adjustment_set_value (adjustment, 5000);
+  while (g_main_context_iteration (NULL, FALSE));
+
+  g_assert_cmpuint (check_bound_rows (list, G_LIST_MODEL (store)), <, 1000);
+  g_assert (gtk_list_box_get_row_at_index (list, 0) == NULL);
+  g_assert_cmpint (count[0], <, 2 * n_rows);
+  g_assert_cmpint (count[1], >, 0);
+  check_selected_row (list, 2);
+  g_assert_cmpint (selection_changes, ==, 0);
+
+  /* changes inside and outside of the rows */
+  g_list_store_remove (store, 0);
+  g_list_store_splice (store, 1000, 5000, NULL, 0);
+  while (g_main_context_iteration (NULL, FALSE));
+  check_bound_rows (list, G_LIST_MODEL (store));
+  check_selected_row (list, 1);
+
+  /* scrolling back restores the selection of the item */
+  gtk_adjustment_set_value (adjustment, 0);
+  while (g_main_context_iteration (NULL, FALSE));
+  check_bound_rows (list, G_LIST_MODEL (store));
+  g_assert (gtk_list_box_get_row_at_index (list, 0) != NULL);
+  check_selected_row (list, 1);
+  g_assert (gtk_list_box_get_selected_row (list) == gtk_list_box_get_row_at_index (list, 1));
+  g_assert_cmpint (selection_changes, ==, 0);
+
+  /* removing the selected item while it has no row changes the selection */
+  gtk_adjustment_set_value (adjustment, 5000);
+  while (g_main_context_iteration (NULL, FALSE));
+  g_list_store_remove (store, 1);
+  g_assert_cmpint (selection_changes, ==, 1);
+  gtk_adjustment_set_value (adjustment, 0);
+  while (g_main_context_iteration (NULL, FALSE));
+  check_selected_row (list, -1);
+
+  gtk_list_box_bind_model (list, NULL, NULL, NULL, NULL);
+  g_assert_cmpuint (check_bound_rows (list, G_LIST_MODEL (store)), ==, 0);
+
+  g_object_unref (list);
+  g_object_unref (store);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -444,6 +632,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/listbox/multi-selection", test_multi_selection);
   g_test_add_func ("/listbox/filter", test_filter);
   g_test_add_func ("/listbox/header", test_header);
+  g_test_add_func ("/listbox/bind-model-virtual", test_bind_model_virtual);
 
   return g_test_run ();
 }
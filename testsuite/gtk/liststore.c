@@ -455,6 +455,109 @@ list_store_test_insert_before_NULL (void)
   g_object_unref (store);
 }
 
+static void
+fill_row (GtkListStore *store,
+          GtkTreeIter  *iter,
+          gint          index,
+          gpointer      user_data)
+{
+  gtk_list_store_set (store, iter, 0, GPOINTER_TO_INT (user_data) + index, -1);
+}
+
+static void
+count_row_changed (GtkTreeModel *model,
+                   GtkTreePath  *path,
+                   GtkTreeIter  *iter,
+                   gpointer      user_data)
+{
+  (*(int *) user_data)++;
+}
+
+static void
+check_row_inserted (GtkTreeModel *model,
+                    GtkTreePath  *path,
+                    GtkTreeIter  *iter,
+                    gpointer      user_data)
+{
+  int *n_inserted = user_data;
+  int value;
+
+  /* rows are announced in order, with their values already set */
+  g_assert_cmpint (gtk_tree_path_get_indices (path)[0], ==, 2 + *n_inserted);
+  gtk_tree_model_get (model, iter, 0, &value, -1);
+  g_assert_cmpint (value, ==, 100 + *n_inserted);
+  g_assert (iter_position (GTK_LIST_STORE (model), iter, 2 + *n_inserted));
+
+  (*n_inserted)++;
+}
+
+static void
+list_store_test_insert_rows (ListStore     *fixture,
+                             gconstpointer  user_data)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL (fixture->store);
+  int n_inserted = 0, n_changed = 0;
+  int expected[] = { 0, 1, 100, 101, 102, 2, 3, 4 };
+  GtkTreeIter iter;
+  guint i;
+  int value;
+
+  g_signal_connect (model, "row-inserted", G_CALLBACK (check_row_inserted), &n_inserted);
+  g_signal_connect (model, "row-changed", G_CALLBACK (count_row_changed), &n_changed);
+
+  gtk_list_store_insert_rows (fixture->store, 2, 3, fill_row, GINT_TO_POINTER (100));
+
+  g_assert_cmpint (n_inserted, ==, 3);
+  g_assert_cmpint (n_changed, ==, 0);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (model, NULL), ==, G_N_ELEMENTS (expected));
+
+  g_assert (gtk_tree_model_get_iter_first (model, &iter));
+  for (i = 0; i < G_N_ELEMENTS (expected); i++)
+    {
+      gtk_tree_model_get (model, &iter, 0, &value, -1);
+      g_assert_cmpint (value, ==, expected[i]);
+      gtk_tree_model_iter_next (model, &iter);
+    }
+
+  /* the old iters stay valid */
+  for (i = 0; i < 5; i++)
+    g_assert (gtk_list_store_iter_is_valid (fixture->store, &fixture->iter[i]));
+}
+
+static void
+list_store_test_insert_rows_sorted (void)
+{
+  GtkListStore *store;
+  GtkTreeModel *model;
+  GtkTreeIter iter;
+  int i, value;
+
+  store = gtk_list_store_new (1, G_TYPE_INT);
+  model = GTK_TREE_MODEL (store);
+  gtk_tree_sortable_set_sort_column_id (GTK_TREE_SORTABLE (store), 0, GTK_SORT_DESCENDING);
+
+  gtk_list_store_insert_rows (store, 0, 10, fill_row, GINT_TO_POINTER (0));
+  gtk_list_store_insert_rows (store, -1, 10, fill_row, GINT_TO_POINTER (5));
+  gtk_list_store_insert_rows (store, 3, 2, NULL, NULL);
+
+  g_assert_cmpint (gtk_tree_model_iter_n_children (model, NULL), ==, 22);
+
+  g_assert (gtk_tree_model_get_iter_first (model, &iter));
+  gtk_tree_model_get (model, &iter, 0, &value, -1);
+  g_assert_cmpint (value, ==, 14);
+  for (i = 1; i < 22; i++)
+    {
+      int prev = value;
+
+      g_assert (gtk_tree_model_iter_next (model, &iter));
+      gtk_tree_model_get (model, &iter, 0, &value, -1);
+      g_assert_cmpint (value, <=, prev);
+    }
+  g_assert_cmpint (value, ==, 0);
+
+  g_object_unref (store);
+}
+
 /* setting values */
 static void
 list_store_set_gvalue_to_transform (void)
@@ -1033,6 +1136,11 @@ register_list_store_tests (void)
 		   list_store_test_insert_before);
   g_test_add_func ("/ListStore/insert-before-NULL",
 		   list_store_test_insert_before_NULL);
+  g_test_add ("/ListStore/insert-rows", ListStore, NULL,
+              list_store_setup, list_store_test_insert_rows,
+              list_store_teardown);
+  g_test_add_func ("/ListStore/insert-rows-sorted",
+                   list_store_test_insert_rows_sorted);
 
   /* setting values (FIXME) */
   g_test_add_func ("/ListStore/set-gvalue-to-transform",
@@ -376,6 +376,119 @@ test_insert_before (void)
   gtk_tree_rbtree_free (tree);
 }
 
+static void
+test_fill (void)
+{
+  guint i;
+
+  for (i = 0; i <= 100; i++)
+    {
+      GtkTreeRBTree *tree;
+      GtkTreeRBNode *node;
+      guint n;
+
+      tree = gtk_tree_rbtree_new ();
+      gtk_tree_rbtree_fill (tree, i, 3, i % 2);
+      gtk_tree_rbtree_test (tree);
+
+      if (i == 0)
+        {
+          g_assert (gtk_tree_rbtree_is_nil (tree->root));
+          gtk_tree_rbtree_free (tree);
+          continue;
+        }
+
+      g_assert (tree->root->count == i);
+      g_assert (tree->root->total_count == i);
+      g_assert (tree->root->offset == i * 3);
+      g_assert (GTK_TREE_RBNODE_FLAG_SET (tree->root, GTK_TREE_RBNODE_DESCENDANTS_INVALID) == !(i % 2));
+
+      n = 0;
+      for (node = gtk_tree_rbtree_first (tree); node; node = gtk_tree_rbtree_next (tree, node))
+        {
+          g_assert (gtk_tree_rbtree_node_get_index (tree, node) == n);
+          g_assert (gtk_tree_rbtree_node_find_offset (tree, node) == n * 3);
+          n++;
+        }
+      g_assert (n == i);
+
+      /* the tree must still work normally */
+      node = gtk_tree_rbtree_insert_after (tree, gtk_tree_rbtree_find_count (tree, i / 2 + 1), 7, TRUE);
+      gtk_tree_rbtree_test (tree);
+      gtk_tree_rbtree_remove_node (tree, gtk_tree_rbtree_first (tree));
+      gtk_tree_rbtree_test (tree);
+      g_assert (tree->root->count == i);
+      g_assert (tree->root->offset == (i - 1) * 3 + 7);
+
+      gtk_tree_rbtree_free (tree);
+    }
+}
+
+static void
+test_fill_children (void)
+{
+  GtkTreeRBTree *tree;
+  GtkTreeRBNode *node;
+
+  tree = create_rbtree (2, 5, FALSE);
+  node = gtk_tree_rbtree_find_count (tree, 3);
+  gtk_tree_rbtree_remove (node->children);
+  g_assert (node->children == NULL);
+
+  node->children = gtk_tree_rbtree_new ();
+  node->children->parent_tree = tree;
+  node->children->parent_node = node;
+  gtk_tree_rbtree_fill (node->children, 1000, 2, FALSE);
+  gtk_tree_rbtree_test (tree);
+
+  g_assert (tree->root->total_count == 5 + 4 * 5 + 1000);
+  g_assert (GTK_TREE_RBNODE_FLAG_SET (tree->root, GTK_TREE_RBNODE_DESCENDANTS_INVALID));
+
+  gtk_tree_rbtree_free (tree);
+}
+
+static void
+test_set_fixed_height (void)
+{
+  GtkTreeRBTree *tree;
+  GtkTreeRBNode *node;
+  guint i;
+
+  tree = create_rbtree (3, 5, FALSE);
+  gtk_tree_rbtree_mark_invalid (tree);
+  g_assert (GTK_TREE_RBNODE_FLAG_SET (tree->root, GTK_TREE_RBNODE_DESCENDANTS_INVALID));
+
+  /* keep one valid node with its own height */
+  node = gtk_tree_rbtree_find_count (tree, 2);
+  gtk_tree_rbtree_node_set_height (tree, node, 50);
+  gtk_tree_rbtree_node_mark_valid (tree, node);
+
+  gtk_tree_rbtree_set_fixed_height (tree, 10, FALSE);
+  gtk_tree_rbtree_test (tree);
+  g_assert (tree->root->offset == (5 + 25 + 125 - 1) * 10 + 50);
+  g_assert (GTK_TREE_RBNODE_FLAG_SET (tree->root, GTK_TREE_RBNODE_DESCENDANTS_INVALID));
+
+  gtk_tree_rbtree_set_fixed_height (tree, 20, TRUE);
+  gtk_tree_rbtree_test (tree);
+  g_assert (tree->root->offset == (5 + 25 + 125 - 1) * 20 + 50);
+  g_assert (!GTK_TREE_RBNODE_FLAG_SET (tree->root, GTK_TREE_RBNODE_DESCENDANTS_INVALID));
+
+  /* only invalid nodes are changed */
+  gtk_tree_rbtree_set_fixed_height (tree, 30, TRUE);
+  g_assert (tree->root->offset == (5 + 25 + 125 - 1) * 20 + 50);
+
+  /* a child tree on its own */
+  node = gtk_tree_rbtree_find_count (tree, 4);
+  for (i = 1; i <= 5; i++)
+    gtk_tree_rbtree_node_mark_invalid (node->children, gtk_tree_rbtree_find_count (node->children, i));
+  gtk_tree_rbtree_set_fixed_height (node->children, 1, TRUE);
+  gtk_tree_rbtree_test (tree);
+  g_assert (tree->root->offset == (5 + 25 + 125 - 1 - 5) * 20 + 50 + 5);
+  g_assert (!GTK_TREE_RBNODE_FLAG_SET (tree->root, GTK_TREE_RBNODE_DESCENDANTS_INVALID));
+
+  gtk_tree_rbtree_free (tree);
+}
+
 static void
 test_remove_node (void)
 {
@@ -519,6 +632,9 @@ main (int   argc,
   g_test_add_func ("/rbtree/create", test_create);
   g_test_add_func ("/rbtree/insert_after", test_insert_after);
   g_test_add_func ("/rbtree/insert_before", test_insert_before);
+  g_test_add_func ("/rbtree/fill", test_fill);
+  g_test_add_func ("/rbtree/fill_children", test_fill_children);
+  g_test_add_func ("/rbtree/set_fixed_height", test_set_fixed_height);
   g_test_add_func ("/rbtree/remove_node", test_remove_node);
   g_test_add_func ("/rbtree/remove_root", test_remove_root);
   g_test_add_func ("/rbtree/reorder", test_reorder);
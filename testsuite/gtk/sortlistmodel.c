@@ -292,9 +292,7 @@ test_set_sort_func (void)
 
   gtk_sort_list_model_set_sort_func (sort, compare, NULL, NULL);
   assert_model (sort, "2 4 6 8 10");
-  /* Technically, this is correct, but we shortcut setting the sort func:
-   * assert_changes (sort, "0-4+4"); */
-  assert_changes (sort, "0-5+5");
+  assert_changes (sort, "0-4+4");
 
   g_object_unref (store);
   g_object_unref (sort);
@@ -380,6 +378,209 @@ test_remove_items (void)
   g_object_unref (sort);
 }
 
+static void
+test_resort (void)
+{
+  GtkSortListModel *sort;
+  GListStore *store;
+  GObject *object;
+
+  store = new_store ((guint[]) { 40, 10, 70, 30, 20, 60, 50, 0 });
+  sort = new_model (store);
+  assert_model (sort, "10 20 30 40 50 60 70");
+  assert_changes (sort, "");
+
+  /* nothing changed */
+  gtk_sort_list_model_resort (sort);
+  assert_changes (sort, "");
+
+  object = g_list_model_get_item (G_LIST_MODEL (store), 3);
+  g_object_set_qdata (object, number_quark, GUINT_TO_POINTER (55));
+  g_object_unref (object);
+  gtk_sort_list_model_resort (sort);
+  assert_model (sort, "10 20 40 50 55 60 70");
+  assert_changes (sort, "2-3+3");
+
+  g_object_unref (store);
+  g_object_unref (sort);
+}
+
+static gboolean
+is_sorted (GListModel *model)
+{
+  guint i, n_items;
+
+  n_items = g_list_model_get_n_items (model);
+  for (i = 1; i < n_items; i++)
+    {
+      if (get (model, i - 1) > get (model, i))
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+splice_many (GListStore *store,
+             guint       pos,
+             guint      *numbers,
+             guint       added)
+{
+  GPtrArray *objects;
+  guint i;
+
+  /* splice() allocates on the stack, which is too small for this */
+  objects = g_ptr_array_new_full (added, g_object_unref);
+  for (i = 0; i < added; i++)
+    {
+      GObject *object = g_object_new (G_TYPE_OBJECT, NULL);
+      g_object_set_qdata (object, number_quark, GUINT_TO_POINTER (numbers[i]));
+      g_ptr_array_add (objects, object);
+    }
+
+  g_list_store_splice (store, pos, 0, objects->pdata, added);
+
+  g_ptr_array_unref (objects);
+}
+
+static void
+test_add_many (void)
+{
+  guint n = g_test_perf () ? 100000 : 1000;
+  GtkSortListModel *sort;
+  GListStore *store;
+  guint *numbers;
+  char *expected;
+  double elapsed;
+  guint i;
+
+  numbers = g_new (guint, n);
+  for (i = 0; i < n; i++)
+    numbers[i] = g_test_rand_int_range (1, G_MAXINT);
+
+  store = new_empty_store ();
+  sort = new_model (store);
+
+  g_test_timer_start ();
+  splice_many (store, 0, numbers, n);
+  elapsed = g_test_timer_elapsed ();
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "adding %u items to a sort model: %gsec", n, elapsed);
+
+  g_assert_cmpint (g_list_model_get_n_items (G_LIST_MODEL (sort)), ==, n);
+  g_assert_true (is_sorted (G_LIST_MODEL (sort)));
+  expected = g_strdup_printf ("0+%u", n);
+  assert_changes (sort, expected);
+  g_free (expected);
+
+  /* add the same items again, interleaving them with the existing ones */
+  g_test_timer_start ();
+  splice_many (store, n / 2, numbers, n);
+  elapsed = g_test_timer_elapsed ();
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "merging %u items into a sort model with %u items: %gsec", n, n, elapsed);
+
+  g_assert_cmpint (g_list_model_get_n_items (G_LIST_MODEL (sort)), ==, 2 * n);
+  g_assert_true (is_sorted (G_LIST_MODEL (sort)));
+  g_string_set_size (g_object_get_qdata (G_OBJECT (sort), changes_quark), 0);
+
+  g_object_unref (store);
+  g_object_unref (sort);
+  g_free (numbers);
+}
+
+static gpointer
+get_modulo_key (gpointer item,
+                gpointer modulo)
+{
+  guint *key = g_new (guint, 1);
+
+  *key = GPOINTER_TO_UINT (g_object_get_qdata (G_OBJECT (item), number_quark)) % GPOINTER_TO_UINT (modulo);
+
+  return key;
+}
+
+static int
+compare_keys (gconstpointer first,
+              gconstpointer second,
+              gpointer      unused)
+{
+  return *(const guint *) first - *(const guint *) second;
+}
+
+static void
+test_sort_keys (void)
+{
+  GtkSortListModel *sort;
+  GListStore *store;
+
+  store = new_store ((guint[]) { 4, 8, 2, 6, 10, 0 });
+  sort = new_model (store);
+  assert_model (sort, "2 4 6 8 10");
+  assert_changes (sort, "");
+
+  gtk_sort_list_model_set_sort_key_func (sort, get_modulo_key, g_free, compare_keys, GUINT_TO_POINTER (5), NULL);
+  assert_model (sort, "10 6 2 8 4");
+  assert_changes (sort, "0-5+5");
+
+  splice (store, 2, 1, (guint[]) { 7, 3 }, 2);
+  assert_model (sort, "10 6 7 8 3 4");
+  assert_changes (sort, "2-2+3");
+
+  gtk_sort_list_model_set_sort_func (sort, compare, NULL, NULL);
+  assert_model (sort, "3 4 6 7 8 10");
+  assert_changes (sort, "0-6+6");
+
+  g_object_unref (store);
+  g_object_unref (sort);
+}
+
+static void
+test_incremental (void)
+{
+  guint n = 10000;
+  GtkSortListModel *sort;
+  GListStore *store;
+  guint *numbers;
+  guint i;
+
+  numbers = g_new (guint, n);
+  for (i = 0; i < n; i++)
+    numbers[i] = n - i;
+
+  store = new_empty_store ();
+  splice_many (store, 0, numbers, n);
+  sort = new_model (NULL);
+  gtk_sort_list_model_set_incremental (sort, TRUE);
+  g_assert_true (gtk_sort_list_model_get_incremental (sort));
+  gtk_sort_list_model_set_model (sort, G_LIST_MODEL (store));
+  g_assert_cmpint (gtk_sort_list_model_get_pending (sort), ==, 0);
+  assert_changes (sort, "0+10000");
+
+  gtk_sort_list_model_set_sort_func (sort, compare, NULL, NULL);
+  /* The previous order stays until sorting is done */
+  g_assert_cmpint (gtk_sort_list_model_get_pending (sort), >, 0);
+  g_assert_cmpint (get (G_LIST_MODEL (sort), 0), ==, n);
+  assert_changes (sort, "");
+
+  while (gtk_sort_list_model_get_pending (sort) > 0)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_true (is_sorted (G_LIST_MODEL (sort)));
+  assert_changes (sort, "0-10000+10000");
+
+  gtk_sort_list_model_set_sort_func (sort, compare_modulo, GUINT_TO_POINTER (2), NULL);
+  g_assert_cmpint (gtk_sort_list_model_get_pending (sort), >, 0);
+  gtk_sort_list_model_set_incremental (sort, FALSE);
+  g_assert_cmpint (gtk_sort_list_model_get_pending (sort), ==, 0);
+  g_assert_cmpint (get (G_LIST_MODEL (sort), 0) % 2, ==, 0);
+  g_assert_cmpint (get (G_LIST_MODEL (sort), n - 1) % 2, ==, 1);
+  assert_changes (sort, "0-10000+10000");
+
+  g_object_unref (store);
+  g_object_unref (sort);
+  g_free (numbers);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -397,7 +598,11 @@ main (int argc, char *argv[])
 #if GLIB_CHECK_VERSION (2, 58, 0) /* g_list_store_splice() is broken before 2.58 */
   g_test_add_func ("/sortlistmodel/add_items", test_add_items);
   g_test_add_func ("/sortlistmodel/remove_items", test_remove_items);
+  g_test_add_func ("/sortlistmodel/add_many", test_add_many);
+  g_test_add_func ("/sortlistmodel/sort-keys", test_sort_keys);
+  g_test_add_func ("/sortlistmodel/incremental", test_incremental);
 #endif
+  g_test_add_func ("/sortlistmodel/resort", test_resort);
 
   return g_test_run ();
 }
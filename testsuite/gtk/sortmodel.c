@@ -1030,6 +1030,140 @@ sorted_insert (void)
 }
 
 
+/* Same ordering as the default column sort, but going through the
+ * compare function for every comparison.
+ */
+static gint
+reference_sort_func (GtkTreeModel *model,
+                     GtkTreeIter  *a,
+                     GtkTreeIter  *b,
+                     gpointer      user_data)
+{
+  int column = GPOINTER_TO_INT (user_data);
+  GValue value_a = G_VALUE_INIT;
+  GValue value_b = G_VALUE_INIT;
+  int retval;
+
+  gtk_tree_model_get_value (model, a, column, &value_a);
+  gtk_tree_model_get_value (model, b, column, &value_b);
+
+  switch (G_VALUE_TYPE (&value_a))
+    {
+    case G_TYPE_INT:
+      retval = (g_value_get_int (&value_a) > g_value_get_int (&value_b)) -
+               (g_value_get_int (&value_a) < g_value_get_int (&value_b));
+      break;
+    case G_TYPE_DOUBLE:
+      retval = (g_value_get_double (&value_a) > g_value_get_double (&value_b)) -
+               (g_value_get_double (&value_a) < g_value_get_double (&value_b));
+      break;
+    case G_TYPE_STRING:
+      retval = g_utf8_collate (g_value_get_string (&value_a) ? g_value_get_string (&value_a) : "",
+                               g_value_get_string (&value_b) ? g_value_get_string (&value_b) : "");
+      break;
+    default:
+      g_assert_not_reached ();
+    }
+
+  g_value_unset (&value_a);
+  g_value_unset (&value_b);
+
+  return retval;
+}
+
+static void
+sort_by_key (void)
+{
+  const char *strings[] = { "apple", "Banana", "cherry", "épée", "zebra", "", NULL, "10", "9" };
+  GtkListStore *store;
+  GtkTreeModel *sort_model, *reference;
+  int column;
+  int i;
+
+  store = gtk_list_store_new (3, G_TYPE_INT, G_TYPE_DOUBLE, G_TYPE_STRING);
+  for (i = 0; i < 200; i++)
+    {
+      double d = g_test_rand_int_range (-50, 50) / 4.0;
+
+      gtk_list_store_insert_with_values (store, NULL, -1,
+                                         0, g_test_rand_int_range (-1000, 1000) * 1000000,
+                                         1, d == 0.0 && g_test_rand_bit () ? -0.0 : d,
+                                         2, strings[g_test_rand_int_range (0, G_N_ELEMENTS (strings))],
+                                         -1);
+    }
+
+  for (column = 0; column < 3; column++)
+    {
+      GtkSortType order;
+
+      for (order = GTK_SORT_ASCENDING; order <= GTK_SORT_DESCENDING; order++)
+        {
+          GtkTreeIter iter, ref_iter, child_iter, prev_child_iter;
+          int prev_offset = -1;
+          gboolean valid;
+
+          sort_model = gtk_tree_model_sort_new_with_model (GTK_TREE_MODEL (store));
+          gtk_tree_sortable_set_sort_column_id (GTK_TREE_SORTABLE (sort_model), column, order);
+
+          reference = gtk_tree_model_sort_new_with_model (GTK_TREE_MODEL (store));
+          gtk_tree_sortable_set_sort_func (GTK_TREE_SORTABLE (reference), column,
+                                           reference_sort_func, GINT_TO_POINTER (column), NULL);
+          gtk_tree_sortable_set_sort_column_id (GTK_TREE_SORTABLE (reference), column, order);
+
+          valid = gtk_tree_model_get_iter_first (sort_model, &iter);
+          g_assert (gtk_tree_model_get_iter_first (reference, &ref_iter));
+
+          while (valid)
+            {
+              GtkTreeIter ref_child_iter;
+              GtkTreePath *path;
+              int offset;
+
+              gtk_tree_model_sort_convert_iter_to_child_iter (GTK_TREE_MODEL_SORT (sort_model),
+                                                              &child_iter, &iter);
+              gtk_tree_model_sort_convert_iter_to_child_iter (GTK_TREE_MODEL_SORT (reference),
+                                                              &ref_child_iter, &ref_iter);
+
+              /* same values as sorting with the compare function */
+              g_assert_cmpint (reference_sort_func (GTK_TREE_MODEL (store),
+                                                    &child_iter, &ref_child_iter,
+                                                    GINT_TO_POINTER (column)), ==, 0);
+
+              path = gtk_tree_model_get_path (GTK_TREE_MODEL (store), &child_iter);
+              offset = gtk_tree_path_get_indices (path)[0];
+              gtk_tree_path_free (path);
+
+              if (prev_offset >= 0)
+                {
+                  int cmp;
+
+                  cmp = reference_sort_func (GTK_TREE_MODEL (store),
+                                             &prev_child_iter, &child_iter,
+                                             GINT_TO_POINTER (column));
+                  if (order == GTK_SORT_DESCENDING)
+                    cmp = -cmp;
+
+                  g_assert_cmpint (cmp, <=, 0);
+                  /* equal rows keep their order */
+                  if (cmp == 0)
+                    g_assert_cmpint (prev_offset, <, offset);
+                }
+
+              prev_child_iter = child_iter;
+              prev_offset = offset;
+
+              valid = gtk_tree_model_iter_next (sort_model, &iter);
+              g_assert (gtk_tree_model_iter_next (reference, &ref_iter) == valid);
+            }
+
+          g_object_unref (reference);
+          g_object_unref (sort_model);
+        }
+    }
+
+  g_object_unref (store);
+}
+
 static void
 specific_bug_300089 (void)
 {
@@ -1317,6 +1451,8 @@ register_sort_model_tests (void)
                    rows_reordered_two_levels);
   g_test_add_func ("/TreeModelSort/sorted-insert",
                    sorted_insert);
+  g_test_add_func ("/TreeModelSort/sort-by-key",
+                   sort_by_key);
 
   g_test_add_func ("/TreeModelSort/specific/bug-300089",
                    specific_bug_300089);
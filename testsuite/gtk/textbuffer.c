@@ -1294,6 +1294,62 @@ test_get_set(void)
   g_object_unref (buffer);
 }
 
+static void
+count_notify (GObject    *object,
+              GParamSpec *pspec,
+              gpointer    data)
+{
+  guint *count = data;
+
+  (*count)++;
+}
+
+static void
+test_user_action (void)
+{
+  GtkTextBuffer *buffer;
+  GtkTextIter iter;
+  guint n_cursor_notifies = 0;
+  guint n_text_notifies = 0;
+  guint i;
+
+  buffer = gtk_text_buffer_new (NULL);
+  g_signal_connect (buffer, "notify::cursor-position", G_CALLBACK (count_notify), &n_cursor_notifies);
+  g_signal_connect (buffer, "notify::text", G_CALLBACK (count_notify), &n_text_notifies);
+
+  for (i = 0; i < 10; i++)
+    {
+      gtk_text_buffer_get_end_iter (buffer, &iter);
+      gtk_text_buffer_insert (buffer, &iter, "line\n", -1);
+    }
+  g_assert_cmpuint (n_cursor_notifies, ==, 10);
+  g_assert_cmpuint (n_text_notifies, ==, 10);
+
+  n_cursor_notifies = 0;
+  n_text_notifies = 0;
+
+  /* Edits in a user action, including nested ones, notify only once */
+  gtk_text_buffer_begin_user_action (buffer);
+  for (i = 0; i < 10; i++)
+    {
+      gtk_text_buffer_begin_user_action (buffer);
+      gtk_text_buffer_get_start_iter (buffer, &iter);
+      gtk_text_buffer_insert (buffer, &iter, "line\n", -1);
+      gtk_text_buffer_end_user_action (buffer);
+    }
+  gtk_text_buffer_get_start_iter (buffer, &iter);
+  gtk_text_buffer_select_range (buffer, &iter, &iter);
+  g_assert_cmpuint (n_cursor_notifies, ==, 0);
+  g_assert_cmpuint (n_text_notifies, ==, 0);
+  gtk_text_buffer_end_user_action (buffer);
+
+  g_assert_cmpuint (n_cursor_notifies, ==, 1);
+  g_assert_cmpuint (n_text_notifies, ==, 1);
+  g_assert_cmpint (gtk_text_buffer_get_line_count (buffer), ==, 21);
+
+  g_object_unref (buffer);
+}
+
 static void
 test_fill_empty (void)
 {
@@ -1596,6 +1652,7 @@ main (int argc, char** argv)
   g_test_add_func ("/TextBuffer/Empty buffer", test_empty_buffer);
   g_test_add_func ("/TextBuffer/Get and Set", test_get_set);
   g_test_add_func ("/TextBuffer/Fill and Empty", test_fill_empty);
+  g_test_add_func ("/TextBuffer/User action", test_user_action);
   g_test_add_func ("/TextBuffer/Tag", test_tag);
   g_test_add_func ("/TextBuffer/Clipboard", test_clipboard);
   g_test_add_func ("/TextBuffer/Get iter", test_get_iter);
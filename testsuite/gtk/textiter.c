@@ -279,6 +279,138 @@ test_search_caseless (void)
   check_found_backward ("aa \303\200", "aa", flags, 0, 2, "aa");
 }
 
+static gboolean
+collect_match (const GtkTextIter *match_start,
+               const GtkTextIter *match_end,
+               gpointer           user_data)
+{
+  GArray *offsets = user_data;
+  int offset;
+
+  offset = gtk_text_iter_get_offset (match_start);
+  g_array_append_val (offsets, offset);
+  offset = gtk_text_iter_get_offset (match_end);
+  g_array_append_val (offsets, offset);
+
+  return offsets->len < 6;
+}
+
+static void
+test_search_all (void)
+{
+  GtkTextBuffer *buffer;
+  GtkTextIter start, end;
+  GtkTextTag *tag;
+  GArray *offsets;
+  guint n;
+
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_text (buffer, "foo bar foo\nfoofoo\nbar Foo\nfoo", -1);
+  offsets = g_array_new (FALSE, FALSE, sizeof (int));
+
+  /* tags split the char segments, matches must still be found */
+  tag = gtk_text_buffer_create_tag (buffer, NULL, "weight", PANGO_WEIGHT_BOLD, NULL);
+  gtk_text_buffer_get_iter_at_offset (buffer, &start, 9);
+  gtk_text_buffer_get_iter_at_offset (buffer, &end, 14);
+  gtk_text_buffer_apply_tag (buffer, tag, &start, &end);
+
+  /* the callback stops after three matches */
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  n = gtk_text_iter_forward_search_all (&start, "foo", 0, NULL, collect_match, offsets);
+  g_assert_cmpuint (n, ==, 3);
+  g_assert_cmpint (g_array_index (offsets, int, 0), ==, 0);
+  g_assert_cmpint (g_array_index (offsets, int, 1), ==, 3);
+  g_assert_cmpint (g_array_index (offsets, int, 2), ==, 8);
+  g_assert_cmpint (g_array_index (offsets, int, 3), ==, 11);
+  g_assert_cmpint (g_array_index (offsets, int, 4), ==, 12);
+  g_assert_cmpint (g_array_index (offsets, int, 5), ==, 15);
+
+  /* continue where the last batch ended */
+  gtk_text_buffer_get_iter_at_offset (buffer, &start, 15);
+  g_array_set_size (offsets, 0);
+  n = gtk_text_iter_forward_search_all (&start, "foo", 0, NULL, collect_match, offsets);
+  g_assert_cmpuint (n, ==, 2);
+  g_assert_cmpint (g_array_index (offsets, int, 0), ==, 15);
+  g_assert_cmpint (g_array_index (offsets, int, 2), ==, 27);
+
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  g_array_set_size (offsets, 0);
+  n = gtk_text_iter_forward_search_all (&start, "foo", GTK_TEXT_SEARCH_CASE_INSENSITIVE, NULL, collect_match, offsets);
+  g_assert_cmpuint (n, ==, 3);
+
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  gtk_text_buffer_get_iter_at_offset (buffer, &end, 14);
+  g_array_set_size (offsets, 0);
+  n = gtk_text_iter_forward_search_all (&start, "foo\nbar", 0, &end, collect_match, offsets);
+  g_assert_cmpuint (n, ==, 0);
+
+  g_array_unref (offsets);
+  g_object_unref (buffer);
+}
+
+static gboolean
+count_match (const GtkTextIter *match_start,
+             const GtkTextIter *match_end,
+             gpointer           user_data)
+{
+  return TRUE;
+}
+
+static void
+test_search_performance (void)
+{
+  guint n_lines = g_test_perf () ? 200000 : 2000;
+  GtkTextBuffer *buffer;
+  GtkTextIter start, end;
+  GString *text;
+  double elapsed;
+  guint i, n;
+
+  text = g_string_new (NULL);
+  for (i = 0; i < n_lines; i++)
+    {
+      if (i % 100 == 99)
+        g_string_append_printf (text, "%u: the needle is on this line\n", i);
+      else
+        g_string_append_printf (text, "%u: some other text without it\n", i);
+    }
+
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_text (buffer, text->str, text->len);
+  g_string_free (text, TRUE);
+
+  g_test_timer_start ();
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  n = 0;
+  while (gtk_text_iter_forward_search (&start, "needle", 0, NULL, &end, NULL))
+    {
+      start = end;
+      n++;
+    }
+  elapsed = g_test_timer_elapsed ();
+  g_assert_cmpuint (n, ==, n_lines / 100);
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "forward search for %u matches in %u lines: %gsec", n, n_lines, elapsed);
+
+  g_test_timer_start ();
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  n = gtk_text_iter_forward_search_all (&start, "needle", 0, NULL, count_match, NULL);
+  elapsed = g_test_timer_elapsed ();
+  g_assert_cmpuint (n, ==, n_lines / 100);
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "search all for %u matches in %u lines: %gsec", n, n_lines, elapsed);
+
+  g_test_timer_start ();
+  gtk_text_buffer_get_start_iter (buffer, &start);
+  n = gtk_text_iter_forward_search_all (&start, "NEEDLE", GTK_TEXT_SEARCH_CASE_INSENSITIVE, NULL, count_match, NULL);
+  elapsed = g_test_timer_elapsed ();
+  g_assert_cmpuint (n, ==, n_lines / 100);
+  if (g_test_perf ())
+    g_test_minimized_result (elapsed, "caseless search all for %u matches in %u lines: %gsec", n, n_lines, elapsed);
+
+  g_object_unref (buffer);
+}
+
 static void
 test_forward_to_tag_toggle (void)
 {
@@ -789,6 +921,8 @@ main (int argc, char** argv)
   g_test_add_func ("/TextIter/Search Full Buffer", test_search_full_buffer);
   g_test_add_func ("/TextIter/Search", test_search);
   g_test_add_func ("/TextIter/Search Caseless", test_search_caseless);
+  g_test_add_func ("/TextIter/Search All", test_search_all);
+  g_test_add_func ("/TextIter/Search Performance", test_search_performance);
   g_test_add_func ("/TextIter/Forward To Tag Toggle", test_forward_to_tag_toggle);
   g_test_add_func ("/TextIter/Forward To Line End", test_forward_to_line_end);
   g_test_add_func ("/TextIter/Word Boundaries", test_word_boundaries);
@@ -0,0 +1,94 @@
+#include <gtk/gtk.h>
+
+#define N_LINES 10
+
+static int
+get_line_height (GtkTextView *text_view,
+                 int          line)
+{
+  GtkTextIter iter;
+  GdkRectangle rect;
+
+  gtk_text_buffer_get_iter_at_line (gtk_text_view_get_buffer (text_view), &iter, line);
+  gtk_text_view_get_iter_location (text_view, &iter, &rect);
+
+  return rect.height;
+}
+
+/* Lines with the same tags share their attributes, and changing
+ * one of the tags clears the attributes of all of them */
+static void
+test_shared_tag_style (void)
+{
+  GtkWidget *window;
+  GtkWidget *text_view;
+  GtkTextBuffer *buffer;
+  GtkTextTag *tag, *other;
+  GtkTextIter start, end;
+  int i, height;
+
+  buffer = gtk_text_buffer_new (NULL);
+  for (i = 0; i < N_LINES; i++)
+    {
+      gtk_text_buffer_get_end_iter (buffer, &end);
+      gtk_text_buffer_insert (buffer, &end, "Some text\n", -1);
+    }
+
+  tag = gtk_text_buffer_create_tag (buffer, "size", "size-points", 10.0, NULL);
+  other = gtk_text_buffer_create_tag (buffer, "weight", "weight", PANGO_WEIGHT_BOLD, NULL);
+  gtk_text_buffer_get_bounds (buffer, &start, &end);
+  gtk_text_buffer_apply_tag (buffer, tag, &start, &end);
+  gtk_text_buffer_apply_tag (buffer, other, &start, &end);
+
+  window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  text_view = gtk_text_view_new_with_buffer (buffer);
+  gtk_container_add (GTK_CONTAINER (window), text_view);
+  gtk_widget_show (window);
+
+  gtk_test_widget_wait_for_draw (window);
+
+  height = get_line_height (GTK_TEXT_VIEW (text_view), 0);
+  g_assert_cmpint (height, >, 0);
+  for (i = 1; i < N_LINES; i++)
+    g_assert_cmpint (get_line_height (GTK_TEXT_VIEW (text_view), i), ==, height);
+
+  /* Drops the attributes, and all lines get the new ones */
+  g_object_set (tag, "size-points", 30.0, NULL);
+
+  gtk_test_widget_wait_for_draw (window);
+
+  for (i = 0; i < N_LINES; i++)
+    g_assert_cmpint (get_line_height (GTK_TEXT_VIEW (text_view), i), >, height);
+
+  height = get_line_height (GTK_TEXT_VIEW (text_view), 0);
+  for (i = 1; i < N_LINES; i++)
+    g_assert_cmpint (get_line_height (GTK_TEXT_VIEW (text_view), i), ==, height);
+
+  /* Changing the tags of a single line doesn't affect the others */
+  gtk_text_buffer_get_iter_at_line (buffer, &start, 3);
+  end = start;
+  gtk_text_iter_forward_line (&end);
+  gtk_text_buffer_remove_tag (buffer, tag, &start, &end);
+
+  gtk_test_widget_wait_for_draw (window);
+
+  g_assert_cmpint (get_line_height (GTK_TEXT_VIEW (text_view), 3), <, height);
+  for (i = 0; i < N_LINES; i++)
+    {
+      if (i != 3)
+        g_assert_cmpint (get_line_height (GTK_TEXT_VIEW (text_view), i), ==, height);
+    }
+
+  gtk_widget_destroy (window);
+  g_object_unref (buffer);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv);
+
+  g_test_add_func ("/textview/shared-tag-style", test_shared_tag_style);
+
+  return g_test_run ();
+}
@@ -458,6 +458,123 @@ tree_store_test_insert_before_NULL (void)
   g_object_unref (store);
 }
 
+static void
+fill_row (GtkTreeStore *store,
+          GtkTreeIter  *iter,
+          gint          index,
+          gpointer      user_data)
+{
+  gtk_tree_store_set (store, iter, 0, GPOINTER_TO_INT (user_data) + index, -1);
+}
+
+typedef struct {
+  int n_inserted;
+  int n_changed;
+  int n_toggled;
+} InsertRowsData;
+
+static void
+insert_rows_row_inserted (GtkTreeModel   *model,
+                          GtkTreePath    *path,
+                          GtkTreeIter    *iter,
+                          InsertRowsData *data)
+{
+  int value;
+
+  /* rows are announced in order, with their values already set */
+  g_assert_cmpint (gtk_tree_path_get_depth (path), ==, 2);
+  g_assert_cmpint (gtk_tree_path_get_indices (path)[1], ==, 1 + data->n_inserted);
+  gtk_tree_model_get (model, iter, 0, &value, -1);
+  g_assert_cmpint (value, ==, 100 + data->n_inserted);
+
+  data->n_inserted++;
+}
+
+static void
+insert_rows_row_changed (GtkTreeModel   *model,
+                         GtkTreePath    *path,
+                         GtkTreeIter    *iter,
+                         InsertRowsData *data)
+{
+  data->n_changed++;
+}
+
+static void
+insert_rows_has_child_toggled (GtkTreeModel   *model,
+                               GtkTreePath    *path,
+                               GtkTreeIter    *iter,
+                               InsertRowsData *data)
+{
+  data->n_toggled++;
+}
+
+static void
+tree_store_test_insert_rows (void)
+{
+  GtkTreeStore *store;
+  GtkTreeModel *model;
+  GtkTreeIter parent, iter;
+  InsertRowsData data = { 0, };
+  int expected[] = { 0, 100, 101, 102, 103, 1 };
+  guint i;
+  int value;
+
+  store = gtk_tree_store_new (1, G_TYPE_INT);
+  model = GTK_TREE_MODEL (store);
+
+  gtk_tree_store_insert_rows (store, NULL, 0, 3, NULL, NULL);
+  g_assert (gtk_tree_model_iter_nth_child (model, &parent, NULL, 1));
+
+  /* the first row added to a childless parent toggles it */
+  gtk_tree_store_insert_rows (store, &parent, -1, 2, fill_row, GINT_TO_POINTER (0));
+
+  g_signal_connect (model, "row-inserted", G_CALLBACK (insert_rows_row_inserted), &data);
+  g_signal_connect (model, "row-changed", G_CALLBACK (insert_rows_row_changed), &data);
+  g_signal_connect (model, "row-has-child-toggled", G_CALLBACK (insert_rows_has_child_toggled), &data);
+
+  gtk_tree_store_insert_rows (store, &parent, 1, 4, fill_row, GINT_TO_POINTER (100));
+
+  g_assert_cmpint (data.n_inserted, ==, 4);
+  g_assert_cmpint (data.n_changed, ==, 0);
+  g_assert_cmpint (data.n_toggled, ==, 0);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (model, NULL), ==, 3);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (model, &parent), ==, G_N_ELEMENTS (expected));
+
+  g_assert (gtk_tree_model_iter_children (model, &iter, &parent));
+  for (i = 0; i < G_N_ELEMENTS (expected); i++)
+    {
+      gtk_tree_model_get (model, &iter, 0, &value, -1);
+      g_assert_cmpint (value, ==, expected[i]);
+      gtk_tree_model_iter_next (model, &iter);
+    }
+
+  g_signal_handlers_disconnect_by_data (model, &data);
+  g_object_unref (store);
+}
+
+static void
+tree_store_test_insert_rows_toggle (void)
+{
+  GtkTreeStore *store;
+  GtkTreeModel *model;
+  GtkTreeIter parent;
+  InsertRowsData data = { 0, };
+
+  store = gtk_tree_store_new (1, G_TYPE_INT);
+  model = GTK_TREE_MODEL (store);
+
+  gtk_tree_store_append (store, &parent, NULL);
+  g_signal_connect (model, "row-has-child-toggled", G_CALLBACK (insert_rows_has_child_toggled), &data);
+
+  gtk_tree_store_insert_rows (store, &parent, 5, 3, fill_row, GINT_TO_POINTER (0));
+
+  g_assert_cmpint (data.n_toggled, ==, 1);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (model, &parent), ==, 3);
+
+  g_signal_handlers_disconnect_by_data (model, &data);
+  g_object_unref (store);
+}
+
 /* setting values */
 static void
 tree_store_set_gvalue_to_transform (void)
@@ -1095,6 +1212,10 @@ register_tree_store_tests (void)
 		   tree_store_test_insert_before);
   g_test_add_func ("/TreeStore/insert-before-NULL",
 		   tree_store_test_insert_before_NULL);
+  g_test_add_func ("/TreeStore/insert-rows",
+                   tree_store_test_insert_rows);
+  g_test_add_func ("/TreeStore/insert-rows-toggle",
+                   tree_store_test_insert_rows_toggle);
 
   /* setting values (FIXME) */
   g_test_add_func ("/TreeStore/set-gvalue-to-transform",
@@ -228,6 +228,72 @@ test_row_separator_height (void)
   gtk_widget_destroy (tree_view);
 }
 
+static int
+get_row_height (GtkTreeView *tree_view,
+                int          row)
+{
+  GtkTreePath *path;
+  GdkRectangle rect;
+
+  path = gtk_tree_path_new_from_indices (row, -1);
+  gtk_tree_view_get_background_area (tree_view, path, NULL, &rect);
+  gtk_tree_path_free (path);
+
+  return rect.height;
+}
+
+/* Rows with the same content share their measured size */
+static void
+test_same_content_height (void)
+{
+  GtkTreeIter iter;
+  GtkListStore *store;
+  GtkWidget *window;
+  GtkWidget *tree_view;
+  int i, short_height, tall_height;
+
+  store = gtk_list_store_new (1, G_TYPE_STRING);
+  for (i = 0; i < 20; i++)
+    gtk_list_store_insert_with_values (store, &iter, i, 0, i % 2 ? "Tall\nrow\ncontent" : "Row content", -1);
+
+  window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+
+  tree_view = gtk_tree_view_new_with_model (GTK_TREE_MODEL (store));
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (tree_view),
+                                               0,
+                                               "Test",
+                                               gtk_cell_renderer_text_new (),
+                                               "text", 0,
+                                               NULL);
+
+  gtk_container_add (GTK_CONTAINER (window), tree_view);
+  gtk_widget_show (window);
+
+  gtk_test_widget_wait_for_draw (window);
+
+  short_height = get_row_height (GTK_TREE_VIEW (tree_view), 0);
+  tall_height = get_row_height (GTK_TREE_VIEW (tree_view), 1);
+  g_assert_cmpint (short_height, <, tall_height);
+
+  for (i = 0; i < 20; i++)
+    g_assert_cmpint (get_row_height (GTK_TREE_VIEW (tree_view), i), ==, i % 2 ? tall_height : short_height);
+
+  /* Changed rows get the size of their new content */
+  gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 4);
+  gtk_list_store_set (store, &iter, 0, "Tall\nrow\ncontent", -1);
+  gtk_tree_model_iter_nth_child (GTK_TREE_MODEL (store), &iter, NULL, 5);
+  gtk_list_store_set (store, &iter, 0, "New\ncontent", -1);
+
+  gtk_test_widget_wait_for_draw (window);
+
+  g_assert_cmpint (get_row_height (GTK_TREE_VIEW (tree_view), 4), ==, tall_height);
+  g_assert_cmpint (get_row_height (GTK_TREE_VIEW (tree_view), 5), >, short_height);
+  g_assert_cmpint (get_row_height (GTK_TREE_VIEW (tree_view), 5), <, tall_height);
+
+  gtk_widget_destroy (window);
+  g_object_unref (store);
+}
+
 static void
 test_selection_count (void)
 {
@@ -348,6 +414,8 @@ main (int    argc,
                    test_select_collapsed_row);
   g_test_add_func ("/TreeView/sizing/row-separator-height",
                    test_row_separator_height);
+  g_test_add_func ("/TreeView/sizing/same-content-height",
+                   test_same_content_height);
   g_test_add_func ("/TreeView/selection/count", test_selection_count);
   g_test_add_func ("/TreeView/selection/empty", test_selection_empty);
 